@@ -1,7 +1,9 @@
 #pragma once
 #include <d3d11.h>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include "Engine/Renderer/Mesh.h"
 #include "Engine/Renderer/Texture2D.h"
@@ -19,25 +21,39 @@ public:
     // Returns a shared handle to the asset; loads on first request, returns
     // the cached instance on subsequent calls while any handle is alive.
     // Returns nullptr on load failure.
-    AssetHandle<Mesh>      GetMesh   (const std::string&  path);
+    //
+    // Safe from any thread (AsyncLoader work included): loads run outside the
+    // cache lock and use only the device. The exception is non-DDS textures,
+    // whose mips are generated on the immediate context; those load on the
+    // main thread only and fail elsewhere.
+    //
+    // keepCPUGeometry asks for a mesh with its collision geometry kept (see
+    // Mesh::Load). A cached copy without it is replaced by a fresh load;
+    // handles to the old copy stay valid.
+    AssetHandle<Mesh>      GetMesh   (const std::string&  path, bool keepCPUGeometry = false);
     AssetHandle<Texture2D> GetTexture(const std::wstring& path);
 
-    // Fallback 1×1 textures for submeshes missing a particular map.
-    AssetHandle<Texture2D> GetDefaultWhite();    // flat white albedo / roughness (all channels = 1.0)
-    AssetHandle<Texture2D> GetDefaultBlack();    // flat black metallic  (all channels = 0.0)
-    AssetHandle<Texture2D> GetDefaultNormal();   // flat tangent-space normal (128,128,255)
+    // Fallback 1×1 textures for submeshes missing a particular map. Created
+    // by Init and kept for the manager's lifetime.
+    AssetHandle<Texture2D> GetDefaultWhite()  const { return m_defaultWhite;  } // flat white albedo / roughness (all channels = 1.0)
+    AssetHandle<Texture2D> GetDefaultBlack()  const { return m_defaultBlack;  } // flat black metallic  (all channels = 0.0)
+    AssetHandle<Texture2D> GetDefaultNormal() const { return m_defaultNormal; } // flat tangent-space normal (128,128,255)
 
     uint32_t CachedMeshCount()    const;
     uint32_t CachedTextureCount() const;
 
 private:
+    AssetHandle<Texture2D> CreateSolid(uint8_t r, uint8_t g, uint8_t b);
+
     ID3D11Device*        m_device  = nullptr;
     ID3D11DeviceContext* m_context = nullptr;
+    std::thread::id      m_mainThread;
+    mutable std::mutex   m_mutex; // guards the two caches
     std::unordered_map<std::string,  std::weak_ptr<Mesh>>     m_meshes;
     std::unordered_map<std::wstring, std::weak_ptr<Texture2D>> m_textures;
-    std::weak_ptr<Texture2D> m_defaultWhite;
-    std::weak_ptr<Texture2D> m_defaultBlack;
-    std::weak_ptr<Texture2D> m_defaultNormal;
+    AssetHandle<Texture2D> m_defaultWhite;
+    AssetHandle<Texture2D> m_defaultBlack;
+    AssetHandle<Texture2D> m_defaultNormal;
 };
 
 } // namespace SE
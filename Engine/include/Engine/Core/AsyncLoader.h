@@ -0,0 +1,71 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace SE {
+
+// Loading work in two halves. Enqueue runs work on a background thread, in
+// order: file I/O, parsing, mesh and DDS texture loads (the device is
+// free-threaded), CPU-side processing. Post hands a step back to the main
+// thread for whatever needs the immediate context or touches live state;
+// Engine::Run pumps steps once a frame until the frame budget is spent. A
+// step should do a bounded slice of work and return false to be called again
+// (next in line, possibly next frame), true once it's done.
+class AsyncLoader
+{
+public:
+    using Work = std::function<void()>;
+    using Step = std::function<bool()>;
+
+    static constexpr double k_DefaultBudgetMs = 4.0;
+
+    AsyncLoader();
+    ~AsyncLoader();
+    AsyncLoader(const AsyncLoader&)            = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    // Any thread.
+    void Enqueue(Work work);
+    void Post(Step step);
+
+    // Main thread. Runs steps until budgetMs has passed; at least one step
+    // call is made if any is queued, so loading always moves forward.
+    void Pump(double budgetMs);
+    void Pump() { Pump(m_budgetMs); }
+
+    // Main thread. Blocks until all background work and every step it leads
+    // to have finished; for loads that have to complete before continuing.
+    void Flush();
+
+    // Drops queued work and steps and stops the thread; the work item running
+    // at the time is finished first. Called by Engine::Shutdown before the
+    // device goes away.
+    void Shutdown();
+
+    bool IsBusy() const;
+
+    void   SetBudget(double ms) { m_budgetMs = ms; }
+    double GetBudget() const    { return m_budgetMs; }
+    // Main-thread time spent in the last Pump.
+    double GetLastPumpMs() const { return m_lastPumpMs; }
+
+private:
+    void WorkerMain();
+
+    std::thread             m_thread;
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_wake;   // work queued, or stopping
+    std::condition_variable m_idle;   // background queue drained
+    std::deque<Work>        m_work;
+    std::deque<Step>        m_steps;
+    bool                    m_running = false; // a work item is executing
+    bool                    m_stop    = false;
+
+    double m_budgetMs   = k_DefaultBudgetMs;
+    double m_lastPumpMs = 0.0;
+};
+
+} // namespace SE
@@ -3,6 +3,10 @@
 #include "Engine/Core/Logger.h"
 #include "Engine/Core/Clock.h"
 #include "Engine/Core/ImGuiLayer.h"
+#include "Engine/Core/AsyncLoader.h"
+#include "Engine/Core/FrameArena.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/MemoryStats.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Input/InputManager.h"
@@ -28,6 +32,14 @@ public:
     const InputManager&  GetInput()    const { return m_input; }
     AssetManager&        GetAssets()         { return m_assets; }
     ShaderLibrary&       GetShaders()        { return m_shaders; }
+    // One thread per hardware thread; the main thread is thread 0.
+    JobSystem&           GetJobs()           { return *m_jobs; }
+    // Transient per-frame memory; see FrameArena for lifetimes.
+    FrameArena&          GetFrameArena()     { return m_frameArena; }
+    // Heap and arena use of the previous frame.
+    const FrameMemoryStats& GetFrameMemory() const { return m_frameMemory; }
+    // Background loading; its main-thread steps run each frame before OnUpdate.
+    AsyncLoader&         GetLoader()         { return m_loader; }
 
 protected:
     virtual void OnUpdate() {}
@@ -45,6 +57,11 @@ private:
     InputManager  m_input;
     AssetManager  m_assets;
     ShaderLibrary m_shaders;
+
+    std::unique_ptr<JobSystem> m_jobs;
+    FrameArena                 m_frameArena;
+    FrameMemoryStats           m_frameMemory;
+    AsyncLoader                m_loader;
 };
 
 } // namespace SE
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace SE {
+
+// Bump allocator over a list of blocks. Nothing is freed individually: Reset
+// rewinds to the first block and keeps them all, so once the arena has grown
+// to a frame's peak it stops touching the heap. Not thread-safe.
+class LinearArena
+{
+public:
+    static constexpr size_t k_DefaultBlockSize = 256 * 1024;
+
+    explicit LinearArena(size_t blockSize = k_DefaultBlockSize) : m_blockSize(blockSize) {}
+
+    LinearArena(const LinearArena&)            = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // Uninitialised memory, valid until the next Reset. Requests bigger than
+    // a block get a block of their own, which is kept like any other.
+    void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    template<typename T>
+    T* AllocateArray(size_t count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+
+    void Reset();
+
+    size_t   GetBytesAllocated() const { return m_allocated; } // since Reset
+    size_t   GetCapacity()       const { return m_capacity; }
+    uint32_t GetBlockCount()     const { return static_cast<uint32_t>(m_blocks.size()); }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        size_t                           size;
+    };
+
+    std::vector<Block> m_blocks;
+    size_t             m_blockSize;
+    size_t             m_current   = 0; // block being bumped
+    size_t             m_offset    = 0; // into m_blocks[m_current]
+    size_t             m_allocated = 0;
+    size_t             m_capacity  = 0;
+};
+
+// Two linear arenas used on alternate frames. Memory handed out during frame
+// N stays valid through frame N + 1 and is reclaimed when frame N + 2 begins,
+// so last frame's data can still be read while this frame's is built. The
+// Engine calls BeginFrame at the top of every frame; main thread only.
+class FrameArena
+{
+public:
+    void BeginFrame()
+    {
+        m_current ^= 1;
+        m_arenas[m_current].Reset();
+        ++m_frame;
+    }
+
+    LinearArena& Current() { return m_arenas[m_current]; }
+
+    void* Allocate(size_t size, size_t align = alignof(std::max_align_t)) { return Current().Allocate(size, align); }
+
+    template<typename T>
+    T* AllocateArray(size_t count) { return Current().AllocateArray<T>(count); }
+
+    size_t   GetBytesThisFrame() const { return m_arenas[m_current].GetBytesAllocated(); }
+    size_t   GetCapacity()       const { return m_arenas[0].GetCapacity() + m_arenas[1].GetCapacity(); }
+    uint64_t GetFrameIndex()     const { return m_frame; }
+
+private:
+    LinearArena m_arenas[2];
+    uint32_t    m_current = 0;
+    uint64_t    m_frame   = 0;
+};
+
+// STL allocator over a LinearArena. deallocate is a no-op; the memory comes
+// back when the arena resets, so a container using one must be rebuilt (not
+// just cleared) before that. With no arena it falls back to the heap, which
+// keeps containers default-constructible.
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(LinearArena* arena) noexcept : m_arena(arena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+    T* allocate(size_t count)
+    {
+        if (m_arena) return m_arena->AllocateArray<T>(count);
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept
+    {
+        if (!m_arena) ::operator delete(p);
+    }
+
+    LinearArena* GetArena() const { return m_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return m_arena == other.GetArena(); }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return m_arena != other.GetArena(); }
+
+private:
+    LinearArena* m_arena = nullptr;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace SE
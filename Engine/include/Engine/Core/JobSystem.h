@@ -0,0 +1,206 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SE {
+
+class JobSystem;
+struct Job;
+
+// Counts outstanding jobs. Spawn increments it, the job's completion
+// decrements it; JobSystem::Wait returns once it is back to zero, and jobs
+// spawned with it as their dependency start then. Reuse a counter only after
+// it has reached zero.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&)            = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    uint32_t GetValue() const { return m_value.load(std::memory_order_acquire); }
+    bool     IsDone()   const { return GetValue() == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_value{ 0 };
+    std::mutex            m_mutex;   // taken for the last decrement and for parking
+    std::vector<Job*>     m_waiters; // jobs parked until m_value hits zero
+};
+
+// One unit of work: a callable stored inline, so spawning doesn't allocate.
+struct Job
+{
+    static constexpr size_t k_StorageSize = 64;
+
+    void (*invoke)(Job&)      = nullptr; // runs and destroys the callable
+    JobCounter*       counter = nullptr;
+    std::atomic<bool> pending{ false }; // slot in use, owned by its thread's ring
+    bool              heap    = false;  // from outside the system, or the ring was full
+    std::max_align_t  storage[k_StorageSize / sizeof(std::max_align_t)];
+};
+
+// Fork/join jobs on a fixed set of threads. The thread that creates the
+// system is thread 0 and takes part whenever it waits; the rest are workers.
+// Each thread owns a Chase-Lev deque: it pushes and pops at the bottom, idle
+// threads steal from the top, so recursive splits stay cache-local and only
+// the oldest (largest) work migrates. There are no fibers: Wait runs other
+// jobs until its counter drains, and a job with an unfinished dependency is
+// parked on that counter rather than blocking a thread.
+class JobSystem
+{
+public:
+    // 0 = one thread per hardware thread.
+    explicit JobSystem(uint32_t threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Workers plus thread 0.
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+    // Runs fn() on some thread. counter, if given, covers the job; dependency,
+    // if given, holds the job back until it reaches zero. fn's captures must
+    // fit Job::k_StorageSize. Threads outside the system may spawn too, at the
+    // cost of a lock and an allocation; so does a thread with thousands of
+    // jobs outstanding.
+    template<typename Fn>
+    void Spawn(Fn&& fn, JobCounter* counter = nullptr, JobCounter* dependency = nullptr)
+    {
+        using F = std::decay_t<Fn>;
+        static_assert(sizeof(F) <= Job::k_StorageSize, "job captures too large; capture by pointer");
+        static_assert(alignof(F) <= alignof(std::max_align_t), "over-aligned job");
+
+        Job* job = AllocateJob();
+        new (job->storage) F(std::forward<Fn>(fn));
+        job->invoke = [](Job& j)
+        {
+            F& f = *std::launder(reinterpret_cast<F*>(j.storage));
+            f();
+            f.~F();
+        };
+        job->counter = counter;
+        if (counter) counter->m_value.fetch_add(1, std::memory_order_relaxed);
+
+        if (dependency) Schedule(job, *dependency);
+        else            Push(job);
+    }
+
+    // Runs jobs on this thread until counter reaches zero. From a thread
+    // outside the system it can only steal, but still helps.
+    void Wait(JobCounter& counter);
+
+    // fn(i) for every i in [0, count), in ranges of at most grain indices,
+    // and returns when all are done. Ranges are split in halves as they are
+    // stolen, so a handful of spawns spreads the loop over every thread.
+    // Nested calls from inside jobs are fine.
+    template<typename Fn>
+    void ParallelFor(uint32_t count, uint32_t grain, const Fn& fn)
+    {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        JobCounter done;
+        SpawnRange(0, count, grain, &fn, &done);
+        Wait(done);
+    }
+
+    // This thread's index in the system it belongs to, or k_NotAWorker.
+    static constexpr uint32_t k_NotAWorker = ~0u;
+    static uint32_t GetThreadIndex();
+
+private:
+    // Fixed-size Chase-Lev work-stealing deque (Lê et al., "Correct and
+    // Efficient Work-Stealing for Weak Memory Models", 2013).
+    class WorkDeque
+    {
+    public:
+        static constexpr int64_t k_Capacity = 4096;
+
+        bool Push(Job* job);  // owner only; false when full
+        Job* Pop();           // owner only
+        Job* Steal();         // any thread; nullptr when empty or lost a race
+
+    private:
+        // top is hammered by thieves, bottom by the owner: keep them on
+        // separate cache lines.
+        std::atomic<int64_t> m_top{ 0 };
+        char                 m_pad[64 - sizeof(std::atomic<int64_t>)];
+        std::atomic<int64_t> m_bottom{ 0 };
+        std::atomic<Job*>    m_jobs[k_Capacity];
+    };
+
+    struct ThreadState
+    {
+        WorkDeque              deque;
+        std::unique_ptr<Job[]> ring; // job slots, reused round-robin
+        uint32_t               next = 0;
+        uint32_t               rng  = 0; // steal victim choice
+    };
+
+    static constexpr uint32_t k_RingSize = 4096;
+
+    template<typename Fn>
+    void SpawnRange(uint32_t begin, uint32_t end, uint32_t grain, const Fn* fn, JobCounter* done)
+    {
+        Spawn([this, begin, end, grain, fn, done]
+        {
+            uint32_t last = end;
+            while (last - begin > grain)
+            {
+                const uint32_t mid = begin + (last - begin) / 2;
+                SpawnRange(mid, last, grain, fn, done);
+                last = mid;
+            }
+            for (uint32_t i = begin; i < last; ++i) (*fn)(i);
+        }, done);
+    }
+
+    uint32_t Self() const; // this thread's index here, or k_NotAWorker
+    Job*     AllocateJob();
+    void     Push(Job* job);
+    void     Schedule(Job* job, JobCounter& dependency);
+    void     Execute(Job* job);
+    void     Complete(JobCounter& counter);
+    Job*     FindJob(uint32_t self);
+    bool     RunOne(uint32_t self);
+    void     WorkerMain(uint32_t index);
+
+    std::vector<std::unique_ptr<ThreadState>> m_threads; // [0] = creating thread
+    std::vector<std::thread>                  m_workers;
+
+    // Jobs spawned from threads outside the system, or that overflowed a deque.
+    std::mutex            m_injectMutex;
+    std::vector<Job*>     m_injected;
+    std::atomic<uint32_t> m_injectedCount{ 0 };
+
+    // Idle workers sleep here; m_queued counts jobs not yet picked up.
+    std::mutex              m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<uint32_t>   m_queued{ 0 };
+    std::atomic<uint32_t>   m_sleeping{ 0 };
+    std::atomic<bool>       m_quit{ false };
+};
+
+// jobs->ParallelFor(count, grain, fn), or the same loop inline when jobs is
+// nullptr, for code that can run with or without a job system.
+template<typename Fn>
+void ParallelFor(JobSystem* jobs, uint32_t count, uint32_t grain, const Fn& fn)
+{
+    if (jobs)
+        jobs->ParallelFor(count, grain, fn);
+    else
+        for (uint32_t i = 0; i < count; ++i) fn(i);
+}
+
+} // namespace SE
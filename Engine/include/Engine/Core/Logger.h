@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdio>
+#include <mutex>
 #include <windows.h>
 
 namespace SE {
@@ -18,8 +19,9 @@ public:
 private:
     Logger() = default;
 
-    FILE* m_logFile    = nullptr;
-    bool  m_hasConsole = false;
+    FILE*      m_logFile    = nullptr;
+    bool       m_hasConsole = false;
+    std::mutex m_mutex; // lines from the loader and job threads stay whole
 };
 
 } // namespace SE
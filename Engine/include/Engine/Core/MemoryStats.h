@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace SE {
+
+// Running totals kept by the engine's replacement global operator new and
+// delete (MemoryStats.cpp), for every thread. Over-aligned new goes to the
+// runtime's own allocator and isn't counted.
+//
+// The replacement is only compiled with SE_HEAP_COUNTERS (the CMake option
+// of that name, on by default outside Release); without it the counters
+// stay at zero and the runtime's allocator is left alone.
+#ifdef SE_HEAP_COUNTERS
+constexpr bool k_HeapCounters = true;
+#else
+constexpr bool k_HeapCounters = false;
+#endif
+
+struct HeapCounters
+{
+    uint64_t allocations = 0;
+    uint64_t frees       = 0;
+    uint64_t bytes       = 0; // requested, over all allocations
+};
+
+HeapCounters GetHeapCounters();
+
+// What one pass through Engine::Run cost.
+struct FrameMemoryStats
+{
+    uint64_t heapAllocations = 0;
+    uint64_t heapBytes       = 0;
+    size_t   arenaBytes      = 0; // from the frame arena
+    size_t   arenaCapacity   = 0; // both halves
+};
+
+} // namespace SE
@@ -0,0 +1,136 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace SE {
+
+// Occupancy of a block-based pool.
+struct PoolStats
+{
+    uint32_t live     = 0; // objects constructed
+    uint32_t capacity = 0; // objects the blocks can hold
+    uint32_t blocks   = 0;
+    size_t   bytes    = 0; // block memory
+};
+
+// Objects of one type in fixed-size blocks, with freed slots kept on an
+// intrusive free list. Create takes the most recently freed slot, so after
+// warm-up creating and destroying never reaches the heap. Objects never move;
+// blocks are only released with the pool, which destroys whatever is still
+// live. Not thread-safe.
+template<typename T, uint32_t BlockSize = 256>
+class ObjectPool
+{
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ObjectPool(ObjectPool&& other) noexcept
+        : m_blocks(std::move(other.m_blocks)),
+          m_free(std::exchange(other.m_free, nullptr)),
+          m_live(std::exchange(other.m_live, 0u))
+    {
+        other.m_blocks.clear();
+    }
+
+    ObjectPool& operator=(ObjectPool&& other) noexcept
+    {
+        if (this != &other)
+        {
+            DestroyAll();
+            m_blocks = std::move(other.m_blocks);
+            m_free   = std::exchange(other.m_free, nullptr);
+            m_live   = std::exchange(other.m_live, 0u);
+            other.m_blocks.clear();
+        }
+        return *this;
+    }
+
+    ~ObjectPool() { DestroyAll(); }
+
+    template<typename... Args>
+    T* Create(Args&&... args)
+    {
+        if (!m_free) Grow();
+        Node* node = m_free;
+        m_free     = node->next;
+        T* obj     = new (node->bytes) T(std::forward<Args>(args)...);
+        node->live = true;
+        ++m_live;
+        return obj;
+    }
+
+    // Grows the pool so the next count Creates don't allocate.
+    void Reserve(uint32_t count)
+    {
+        while (static_cast<uint32_t>(m_blocks.size()) * BlockSize - m_live < count) Grow();
+    }
+
+    // obj must have come from this pool's Create.
+    void Destroy(T* obj)
+    {
+        if (!obj) return;
+        obj->~T();
+        Node* node = reinterpret_cast<Node*>(obj);
+        node->live = false;
+        node->next = m_free;
+        m_free     = node;
+        --m_live;
+    }
+
+    PoolStats GetStats() const
+    {
+        PoolStats s;
+        s.live     = m_live;
+        s.blocks   = static_cast<uint32_t>(m_blocks.size());
+        s.capacity = s.blocks * BlockSize;
+        s.bytes    = m_blocks.size() * sizeof(Node) * BlockSize;
+        return s;
+    }
+
+private:
+    // The object sits at offset 0, so T* and Node* convert both ways.
+    struct Node
+    {
+        union
+        {
+            Node*                    next;
+            alignas(T) unsigned char bytes[sizeof(T)];
+        };
+        bool live;
+    };
+
+    void Grow()
+    {
+        std::unique_ptr<Node[]> block(new Node[BlockSize]);
+        // Thread the new slots onto the free list in address order.
+        for (uint32_t i = 0; i < BlockSize; ++i)
+        {
+            block[i].next = i + 1 < BlockSize ? &block[i + 1] : m_free;
+            block[i].live = false;
+        }
+        m_free = &block[0];
+        m_blocks.push_back(std::move(block));
+    }
+
+    void DestroyAll()
+    {
+        for (auto& block : m_blocks)
+            for (uint32_t i = 0; i < BlockSize; ++i)
+                if (block[i].live) reinterpret_cast<T*>(block[i].bytes)->~T();
+        m_blocks.clear();
+        m_free = nullptr;
+        m_live = 0;
+    }
+
+    std::vector<std::unique_ptr<Node[]>> m_blocks;
+    Node*                                m_free = nullptr;
+    uint32_t                             m_live = 0;
+};
+
+} // namespace SE
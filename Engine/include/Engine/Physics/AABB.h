@@ -1,9 +1,14 @@
 #pragma once
 #include <cfloat>
+#include <cstdint>
 #include <DirectXMath.h>
 
 namespace SE {
 
+// How a box relates to a query volume, for hierarchical culling: Inside lets a
+// tree report a whole subtree without testing it further.
+enum class Containment : uint8_t { Outside, Partial, Inside };
+
 struct AABB
 {
     DirectX::XMFLOAT3 min = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
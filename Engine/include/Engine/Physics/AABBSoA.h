@@ -0,0 +1,84 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Engine/Physics/AABB.h"
+
+namespace SE {
+
+// A set of boxes as centre/extents in structure-of-arrays form, so four of
+// them load into one XMVECTOR per component (see Frustum::TestAABBs). The
+// arrays are padded to a multiple of 4 with empty boxes at the origin.
+struct AABBSoA
+{
+    static constexpr uint32_t k_Lanes = 4;
+
+    std::vector<float> cx, cy, cz;
+    std::vector<float> ex, ey, ez;
+    uint32_t           count = 0;
+
+    uint32_t Padded() const { return static_cast<uint32_t>(cx.size()); }
+
+    void Resize(uint32_t n)
+    {
+        count = n;
+        const size_t padded = (n + k_Lanes - 1) / k_Lanes * k_Lanes;
+        for (std::vector<float>* v : { &cx, &cy, &cz, &ex, &ey, &ez })
+            v->assign(padded, 0.0f);
+    }
+
+    void Set(uint32_t i, const AABB& b)
+    {
+        const DirectX::XMFLOAT3 c = b.Center(), e = b.Extents();
+        cx[i] = c.x; cy[i] = c.y; cz[i] = c.z;
+        ex[i] = e.x; ey[i] = e.y; ez[i] = e.z;
+    }
+
+    // this = src moved into the space of an affine (row-vector) matrix. The
+    // result bounds each transformed box: centre through the matrix, extents
+    // through its absolute 3x3 part.
+    void Transform(const AABBSoA& src, DirectX::FXMMATRIX m)
+    {
+        using namespace DirectX;
+        if (Padded() != src.Padded()) Resize(src.count);
+        count = src.count;
+
+        XMFLOAT4X4 f;
+        XMStoreFloat4x4(&f, m);
+        XMVECTOR r[3][3], a[3][3], t[3];
+        for (int row = 0; row < 3; ++row)
+            for (int col = 0; col < 3; ++col)
+            {
+                r[row][col] = XMVectorReplicate(f.m[row][col]);
+                a[row][col] = XMVectorReplicate(std::fabs(f.m[row][col]));
+            }
+        for (int col = 0; col < 3; ++col)
+            t[col] = XMVectorReplicate(f.m[3][col]);
+
+        float* outC[3] = { cx.data(), cy.data(), cz.data() };
+        float* outE[3] = { ex.data(), ey.data(), ez.data() };
+        for (uint32_t i = 0; i < Padded(); i += k_Lanes)
+        {
+            const XMVECTOR c[3] = { XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&src.cx[i])),
+                                    XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&src.cy[i])),
+                                    XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&src.cz[i])) };
+            const XMVECTOR e[3] = { XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&src.ex[i])),
+                                    XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&src.ey[i])),
+                                    XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&src.ez[i])) };
+            for (int col = 0; col < 3; ++col)
+            {
+                XMVECTOR wc = XMVectorMultiplyAdd(c[0], r[0][col], t[col]);
+                wc = XMVectorMultiplyAdd(c[1], r[1][col], wc);
+                wc = XMVectorMultiplyAdd(c[2], r[2][col], wc);
+                XMVECTOR we = XMVectorMultiply(e[0], a[0][col]);
+                we = XMVectorMultiplyAdd(e[1], a[1][col], we);
+                we = XMVectorMultiplyAdd(e[2], a[2][col], we);
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(outC[col] + i), wc);
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(outE[col] + i), we);
+            }
+        }
+    }
+};
+
+} // namespace SE
@@ -0,0 +1,263 @@
+#pragma once
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Engine/Physics/AABB.h"
+#include "Engine/Physics/Ray.h"
+#include "Engine/Physics/RayPacket.h"
+
+namespace SE {
+
+// Bounding volume hierarchy over primitive AABBs. Binned-SAH build, nodes
+// flattened depth-first with siblings adjacent, so a parent always precedes
+// its children (Refit walks the array backwards). Primitives are referenced
+// by index — the caller owns the geometry and does the exact tests.
+class BVH
+{
+public:
+    struct Node
+    {
+        AABB     bounds;
+        uint32_t leftFirst; // interior: left child (right = left + 1); leaf: first slot in prim list
+        uint32_t count;     // primitives in leaf; 0 = interior
+
+        bool IsLeaf() const { return count != 0; }
+    };
+    static_assert(sizeof(Node) == 32, "BVH::Node must stay 32 bytes (two per cache line)");
+
+    void Build(const AABB* primBounds, uint32_t count);
+    // Primitive bounds moved but the set is unchanged — recompute node bounds, keep topology.
+    void Refit(const AABB* primBounds);
+    void Clear();
+
+    // For callers that permute their primitive array into GetPrimIndices() order
+    // after Build (so each leaf's primitives are contiguous in memory): resets the
+    // index list to identity, making callback indices refer to the new order.
+    void AdoptLeafOrder();
+
+    bool     Empty()         const { return m_nodes.empty(); }
+    uint32_t GetNodeCount()  const { return static_cast<uint32_t>(m_nodes.size()); }
+    uint32_t GetPrimCount()  const { return static_cast<uint32_t>(m_primIndices.size()); }
+
+    const std::vector<Node>&     GetNodes()       const { return m_nodes; }
+    const std::vector<uint32_t>& GetPrimIndices() const { return m_primIndices; }
+
+    // Calls fn(primIndex) for every primitive in a leaf whose bounds overlap box.
+    template<typename Fn>
+    void QueryAABB(const AABB& box, Fn&& fn) const;
+
+    // Nearest-first ray traversal. fn(primIndex, tMax) runs the exact test and
+    // returns the new tMax (smaller on hit, unchanged on miss); subtrees beyond
+    // tMax are skipped. inflate > 0 grows every node by that much, which turns
+    // the ray into a sphere sweep of that radius.
+    template<typename Fn>
+    void QueryRay(const Ray& ray, float tMax, Fn&& fn, float inflate = 0.0f) const;
+
+    // Packet traversal for four rays: a node is visited while any lane enters
+    // it before that lane's tMax. fn(primIndex, tMax) takes and returns the
+    // per-lane tMax vector, as QueryRay does for a single ray.
+    template<typename Fn>
+    void QueryRayPacket(const RayPacket4& packet, DirectX::XMVECTOR tMax, Fn&& fn) const;
+
+    // Nearest-first point query. fn(primIndex, maxDistSq) returns the new
+    // maxDistSq; subtrees farther than that are skipped.
+    template<typename Fn>
+    void QueryClosest(DirectX::XMFLOAT3 p, float maxDistSq, Fn&& fn) const;
+
+private:
+    static constexpr uint32_t k_MaxLeafSize = 4;
+    static constexpr uint32_t k_NumBins     = 8;
+    static constexpr uint32_t k_MaxDepth    = 60;
+    static constexpr int      k_StackSize   = 64; // > k_MaxDepth: DFS holds at most depth + 1 nodes
+
+    void Subdivide(uint32_t nodeIndex, uint32_t depth, const AABB* primBounds,
+                   const std::vector<DirectX::XMFLOAT3>& centroids);
+
+    // Slab test against precomputed 1/dir. Returns entry distance or FLT_MAX on miss.
+    static float RayEntry(const AABB& b, const DirectX::XMFLOAT3& o,
+                          const DirectX::XMFLOAT3& invD, float tMax, float inflate);
+    static float DistSq(const AABB& b, const DirectX::XMFLOAT3& p);
+
+    std::vector<Node>     m_nodes;
+    std::vector<uint32_t> m_primIndices;
+};
+
+// ---- template / inline implementation --------------------------------------
+
+inline float BVH::RayEntry(const AABB& b, const DirectX::XMFLOAT3& o,
+                           const DirectX::XMFLOAT3& invD, float tMax, float inflate)
+{
+    float tx0 = (b.min.x - inflate - o.x) * invD.x, tx1 = (b.max.x + inflate - o.x) * invD.x;
+    float ty0 = (b.min.y - inflate - o.y) * invD.y, ty1 = (b.max.y + inflate - o.y) * invD.y;
+    float tz0 = (b.min.z - inflate - o.z) * invD.z, tz1 = (b.max.z + inflate - o.z) * invD.z;
+    float tmin = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), fmaxf(fminf(tz0, tz1), 0.0f));
+    float tmax = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), fminf(fmaxf(tz0, tz1), tMax));
+    return tmin <= tmax ? tmin : FLT_MAX;
+}
+
+inline float BVH::DistSq(const AABB& b, const DirectX::XMFLOAT3& p)
+{
+    float dx = p.x < b.min.x ? b.min.x - p.x : p.x > b.max.x ? p.x - b.max.x : 0.0f;
+    float dy = p.y < b.min.y ? b.min.y - p.y : p.y > b.max.y ? p.y - b.max.y : 0.0f;
+    float dz = p.z < b.min.z ? b.min.z - p.z : p.z > b.max.z ? p.z - b.max.z : 0.0f;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+template<typename Fn>
+void BVH::QueryAABB(const AABB& box, Fn&& fn) const
+{
+    if (m_nodes.empty()) return;
+
+    uint32_t stack[k_StackSize];
+    int      sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0)
+    {
+        const Node& n = m_nodes[stack[--sp]];
+        if (!n.bounds.Overlaps(box)) continue;
+
+        if (n.IsLeaf())
+        {
+            for (uint32_t i = 0; i < n.count; ++i)
+                fn(m_primIndices[n.leftFirst + i]);
+        }
+        else
+        {
+            stack[sp++] = n.leftFirst + 1;
+            stack[sp++] = n.leftFirst;
+        }
+    }
+}
+
+template<typename Fn>
+void BVH::QueryRay(const Ray& ray, float tMax, Fn&& fn, float inflate) const
+{
+    if (m_nodes.empty()) return;
+
+    // Division by zero gives ±inf, which the slab test handles correctly.
+    const DirectX::XMFLOAT3 invD = { 1.0f / ray.direction.x,
+                                     1.0f / ray.direction.y,
+                                     1.0f / ray.direction.z };
+
+    if (RayEntry(m_nodes[0].bounds, ray.origin, invD, tMax, inflate) == FLT_MAX) return;
+
+    uint32_t stack[k_StackSize];
+    float    entry[k_StackSize];
+    int      sp = 0;
+    stack[sp] = 0; entry[sp] = 0.0f; ++sp;
+
+    while (sp > 0)
+    {
+        --sp;
+        if (entry[sp] > tMax) continue; // a closer hit was found after this was pushed
+        const Node& n = m_nodes[stack[sp]];
+
+        if (n.IsLeaf())
+        {
+            for (uint32_t i = 0; i < n.count; ++i)
+                tMax = fn(m_primIndices[n.leftFirst + i], tMax);
+            continue;
+        }
+
+        uint32_t a = n.leftFirst, b = n.leftFirst + 1;
+        float    ta = RayEntry(m_nodes[a].bounds, ray.origin, invD, tMax, inflate);
+        float    tb = RayEntry(m_nodes[b].bounds, ray.origin, invD, tMax, inflate);
+        if (ta > tb) { uint32_t ti = a; a = b; b = ti; float tf = ta; ta = tb; tb = tf; }
+
+        // Push the far child first so the near one is popped next.
+        if (tb != FLT_MAX) { stack[sp] = b; entry[sp] = tb; ++sp; }
+        if (ta != FLT_MAX) { stack[sp] = a; entry[sp] = ta; ++sp; }
+    }
+}
+
+template<typename Fn>
+void BVH::QueryRayPacket(const RayPacket4& packet, DirectX::XMVECTOR tMax, Fn&& fn) const
+{
+    using namespace DirectX;
+    if (m_nodes.empty()) return;
+
+    const XMVECTOR one     = XMVectorReplicate(1.0f);
+    const XMVECTOR miss    = XMVectorReplicate(FLT_MAX);
+    const XMVECTOR invD[3] = { XMVectorDivide(one, packet.dx),
+                               XMVectorDivide(one, packet.dy),
+                               XMVectorDivide(one, packet.dz) };
+
+    // Lanes still interested in a node entered at entry.
+    auto active = [&](FXMVECTOR entry) {
+        return XMVector4NotEqualInt(
+            XMVectorAndInt(XMVectorLess(entry, miss), XMVectorLessOrEqual(entry, tMax)), XMVectorZero());
+    };
+    auto nearest = [](FXMVECTOR entry) {
+        XMFLOAT4A e;
+        XMStoreFloat4A(&e, entry);
+        return fminf(fminf(e.x, e.y), fminf(e.z, e.w));
+    };
+
+    XMVECTOR rootEntry = PacketEntry(packet, invD, m_nodes[0].bounds, tMax);
+    if (!active(rootEntry)) return;
+
+    uint32_t stack[k_StackSize];
+    XMVECTOR entry[k_StackSize];
+    int      sp = 0;
+    stack[sp] = 0; entry[sp] = rootEntry; ++sp;
+
+    while (sp > 0)
+    {
+        --sp;
+        if (!active(entry[sp])) continue; // every lane found something closer meanwhile
+        const Node& n = m_nodes[stack[sp]];
+
+        if (n.IsLeaf())
+        {
+            for (uint32_t i = 0; i < n.count; ++i)
+                tMax = fn(m_primIndices[n.leftFirst + i], tMax);
+            continue;
+        }
+
+        uint32_t a  = n.leftFirst, b = n.leftFirst + 1;
+        XMVECTOR ea = PacketEntry(packet, invD, m_nodes[a].bounds, tMax);
+        XMVECTOR eb = PacketEntry(packet, invD, m_nodes[b].bounds, tMax);
+        if (nearest(ea) > nearest(eb)) { uint32_t ti = a; a = b; b = ti; XMVECTOR te = ea; ea = eb; eb = te; }
+
+        if (active(eb)) { stack[sp] = b; entry[sp] = eb; ++sp; }
+        if (active(ea)) { stack[sp] = a; entry[sp] = ea; ++sp; }
+    }
+}
+
+template<typename Fn>
+void BVH::QueryClosest(DirectX::XMFLOAT3 p, float maxDistSq, Fn&& fn) const
+{
+    if (m_nodes.empty()) return;
+
+    uint32_t stack[k_StackSize];
+    float    dist[k_StackSize];
+    int      sp = 0;
+    stack[sp] = 0; dist[sp] = DistSq(m_nodes[0].bounds, p); ++sp;
+
+    while (sp > 0)
+    {
+        --sp;
+        if (dist[sp] > maxDistSq) continue;
+        const Node& n = m_nodes[stack[sp]];
+
+        if (n.IsLeaf())
+        {
+            for (uint32_t i = 0; i < n.count; ++i)
+                maxDistSq = fn(m_primIndices[n.leftFirst + i], maxDistSq);
+            continue;
+        }
+
+        uint32_t a = n.leftFirst, b = n.leftFirst + 1;
+        float    da = DistSq(m_nodes[a].bounds, p);
+        float    db = DistSq(m_nodes[b].bounds, p);
+        if (da > db) { uint32_t ti = a; a = b; b = ti; float tf = da; da = db; db = tf; }
+
+        if (db <= maxDistSq) { stack[sp] = b; dist[sp] = db; ++sp; }
+        if (da <= maxDistSq) { stack[sp] = a; dist[sp] = da; ++sp; }
+    }
+}
+
+} // namespace SE
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Engine/Physics/AABB.h"
+
+namespace SE {
+
+class JobSystem;
+
+// Candidate pair produced by a broadphase. Always a < b.
+struct BroadphasePair
+{
+    uint32_t a;
+    uint32_t b;
+};
+
+// Dynamic-vs-dynamic broadphase. PhysicsWorld hands it one AABB per body each
+// step and runs narrowphase only on the pairs it returns.
+class Broadphase
+{
+public:
+    virtual ~Broadphase() = default;
+
+    // Replace the tracked bounds. Index i in bounds is body i in PhysicsWorld.
+    virtual void Update(const AABB* bounds, uint32_t count) = 0;
+
+    // Appends overlapping pairs, sorted by (a, b) so resolution order is stable.
+    virtual void FindPairs(std::vector<BroadphasePair>& out) = 0;
+
+    // FindPairs without the pairs where neither body is active (active[i] == 0,
+    // e.g. both asleep). The default filters FindPairs; implementations can
+    // avoid visiting those pairs at all.
+    virtual void FindActivePairs(const uint8_t* active, std::vector<BroadphasePair>& out);
+
+    virtual void Clear() = 0;
+
+    // Jobs the pair search may be split over; PhysicsWorld passes its own.
+    // nullptr runs it inline.
+    void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+
+protected:
+    JobSystem* GetJobSystem() const { return m_jobs; }
+
+private:
+    JobSystem* m_jobs = nullptr;
+};
+
+// Emits every pair unfiltered — the old O(n²) behaviour. Reference for benchmarks.
+class BruteForceBroadphase : public Broadphase
+{
+public:
+    void Update(const AABB* /*bounds*/, uint32_t count) override { m_count = count; }
+    void FindPairs(std::vector<BroadphasePair>& out) override;
+    void Clear() override { m_count = 0; }
+
+private:
+    uint32_t m_count = 0;
+};
+
+// Incremental sort-and-sweep along the axis the box centres spread most on,
+// so a tall stack or a long corridor doesn't put everything in one window.
+// The sorted order persists between steps, so the insertion sort is close to
+// O(n) when bodies move coherently; changing axis costs one full sort, so it
+// only happens once another axis is clearly better. With a job system, the
+// sweep is split into runs of sorted bodies that are searched in parallel.
+class SweepAndPruneBroadphase : public Broadphase
+{
+public:
+    void Update(const AABB* bounds, uint32_t count) override;
+    void FindPairs(std::vector<BroadphasePair>& out) override;
+    // Sweeps only from active bodies: right as usual, and left over the
+    // inactive ones as far as the widest box can reach.
+    void FindActivePairs(const uint8_t* active, std::vector<BroadphasePair>& out) override;
+    void Clear() override;
+
+    // 0 = X, 1 = Y, 2 = Z.
+    int GetSweepAxis() const { return m_axis; }
+
+private:
+    static constexpr uint32_t k_ChunkBodies = 512; // sorted bodies per parallel run
+
+    // Runs sweep(i, pairs) for every sorted position i, in chunks as jobs
+    // when there is a job system, and appends the pairs to out sorted by (a, b).
+    template<typename Sweep>
+    void SweepAll(const Sweep& sweep, std::vector<BroadphasePair>& out);
+
+    // Bounds are stored with the sweep axis swapped into x, so the sweep
+    // itself is the same whichever axis it runs on.
+    std::vector<AABB>     m_bounds;
+    std::vector<AABB>     m_sorted;       // m_bounds in m_order, for the sweep to read in sequence
+    std::vector<uint32_t> m_order;        // body indices sorted by min on the sweep axis
+    float                 m_maxWidth = 0; // widest box on the sweep axis
+    int                   m_axis     = 0;
+    std::vector<std::vector<BroadphasePair>> m_chunkPairs;
+};
+
+// Uniform spatial hash over static shapes' AABBs. Built once (static geometry
+// rarely changes) and queried per body per step.
+class StaticSpatialHash
+{
+public:
+    explicit StaticSpatialHash(float cellSize = 4.0f) : m_cellSize(cellSize) {}
+
+    void SetCellSize(float cellSize) { m_cellSize = cellSize; }
+    void Build(const AABB* bounds, uint32_t count);
+    void Clear();
+
+    // Appends indices of shapes whose AABB overlaps box. Each index appears once.
+    void Query(const AABB& box, std::vector<uint32_t>& out) const;
+
+    uint32_t GetShapeCount() const { return static_cast<uint32_t>(m_bounds.size()); }
+
+private:
+    // Shapes covering more cells than this go into m_oversized instead of the
+    // grid, e.g. a level-wide floor slab.
+    static constexpr int64_t k_MaxCellsPerShape = 4096;
+
+    static uint64_t Key(int32_t x, int32_t y, int32_t z);
+    int32_t         Cell(float v) const;
+
+    float                                               m_cellSize;
+    std::vector<AABB>                                   m_bounds;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+    std::vector<uint32_t>                               m_oversized;
+
+    // Per-shape query stamp for de-duplication across cells.
+    mutable std::vector<uint32_t> m_stamp;
+    mutable uint32_t              m_queryID = 0;
+};
+
+} // namespace SE
@@ -0,0 +1,136 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Engine/Physics/AABB.h"
+
+namespace SE {
+
+// Incremental bounding volume hierarchy for boxes that come, go and move —
+// unlike BVH, which is built once over a fixed set. Each proxy is a leaf with
+// a "fat" box (its bounds grown by a margin), so small movements don't touch
+// the tree at all. A leaf that escapes its fat box is removed and reinserted,
+// refitting its ancestors on the way; inserts pick the sibling by surface-area
+// cost and rotations keep the tree height-balanced.
+class DynamicAABBTree
+{
+public:
+    static constexpr uint32_t k_Null = UINT32_MAX;
+
+    explicit DynamicAABBTree(float margin = 0.1f) : m_margin(margin) {}
+
+    // Returns the proxy id, stable until DestroyProxy. userData comes back in queries.
+    uint32_t CreateProxy(const AABB& bounds, uint32_t userData);
+    void     DestroyProxy(uint32_t proxy);
+    // Returns true if the proxy left its fat box and was reinserted. The new
+    // fat box also reaches k_DisplacementScale times displacement (the move
+    // since the last call) ahead, so steadily moving proxies reinsert less.
+    bool     MoveProxy(uint32_t proxy, const AABB& bounds,
+                       DirectX::XMFLOAT3 displacement = { 0.0f, 0.0f, 0.0f });
+    void     Clear();
+
+    uint32_t    GetUserData(uint32_t proxy) const { return m_nodes[proxy].userData; }
+    const AABB& GetFatAABB(uint32_t proxy)  const { return m_nodes[proxy].bounds; }
+    uint32_t    GetProxyCount() const { return m_proxyCount; }
+    int         GetHeight() const { return m_root == k_Null ? 0 : m_nodes[m_root].height; }
+
+    // classify(const AABB&) -> Containment decides per node: Outside prunes,
+    // Inside reports every proxy below without further tests, Partial
+    // descends. fn(proxyId) is called for each proxy reached; leaves are
+    // classified by their fat box, so results are conservative by the margin.
+    template<typename Classify, typename Fn>
+    void Query(Classify&& classify, Fn&& fn) const;
+
+    template<typename Fn>
+    void QueryAABB(const AABB& box, Fn&& fn) const
+    {
+        Query([&box](const AABB& b) { return b.Overlaps(box) ? Containment::Partial : Containment::Outside; },
+              fn);
+    }
+
+private:
+    static constexpr float k_DisplacementScale = 4.0f;
+
+    // Height-balanced: ~1.44 log2(n) levels, so this covers any practical count.
+    static constexpr int k_StackSize = 256;
+
+    struct Node
+    {
+        AABB     bounds;
+        uint32_t parent   = k_Null; // next free node while on the free list
+        uint32_t child1   = k_Null;
+        uint32_t child2   = k_Null;
+        uint32_t userData = 0;
+        int32_t  height   = -1;     // leaf 0, free -1
+
+        bool IsLeaf() const { return child1 == k_Null; }
+    };
+
+    uint32_t AllocateNode();
+    void     FreeNode(uint32_t node);
+    void     InsertLeaf(uint32_t leaf);
+    void     RemoveLeaf(uint32_t leaf);
+    uint32_t Balance(uint32_t a);
+    void     Refit(uint32_t node); // bounds and heights from node up to the root
+
+    template<typename Fn>
+    void ReportSubtree(uint32_t node, Fn& fn) const;
+
+    std::vector<Node> m_nodes;
+    uint32_t          m_root       = k_Null;
+    uint32_t          m_freeList   = k_Null;
+    uint32_t          m_proxyCount = 0;
+    float             m_margin;
+};
+
+// ---- template implementation -------------------------------------------------
+
+template<typename Classify, typename Fn>
+void DynamicAABBTree::Query(Classify&& classify, Fn&& fn) const
+{
+    if (m_root == k_Null) return;
+
+    uint32_t stack[k_StackSize];
+    int      sp = 0;
+    stack[sp++] = m_root;
+
+    while (sp > 0)
+    {
+        const uint32_t id = stack[--sp];
+        const Node&    n  = m_nodes[id];
+        const Containment c = classify(n.bounds);
+        if (c == Containment::Outside) continue;
+
+        if (c == Containment::Inside)
+            ReportSubtree(id, fn);
+        else if (n.IsLeaf())
+            fn(id);
+        else
+        {
+            stack[sp++] = n.child2;
+            stack[sp++] = n.child1;
+        }
+    }
+}
+
+template<typename Fn>
+void DynamicAABBTree::ReportSubtree(uint32_t node, Fn& fn) const
+{
+    uint32_t stack[k_StackSize];
+    int      sp = 0;
+    stack[sp++] = node;
+
+    while (sp > 0)
+    {
+        const Node& n = m_nodes[stack[--sp]];
+        if (n.IsLeaf())
+            fn(static_cast<uint32_t>(&n - m_nodes.data()));
+        else
+        {
+            stack[sp++] = n.child2;
+            stack[sp++] = n.child1;
+        }
+    }
+}
+
+} // namespace SE
@@ -238,4 +238,113 @@ inline bool Intersects(const OBB& obb, const Sphere& s)
     return sqDist <= s.radius * s.radius;
 }
 
+// Closest point on (or in) an OBB to p.
+inline DirectX::XMFLOAT3 ClosestPoint(const OBB& obb, const DirectX::XMFLOAT3& p)
+{
+    using namespace DirectX;
+
+    XMVECTOR d       = XMVectorSubtract(XMLoadFloat3(&p), XMLoadFloat3(&obb.center));
+    XMVECTOR closest = XMLoadFloat3(&obb.center);
+    for (int i = 0; i < 3; ++i)
+    {
+        XMVECTOR ax   = XMLoadFloat3(&obb.axes[i]);
+        float    proj = XMVectorGetX(XMVector3Dot(d, ax));
+        float    he   = (&obb.halfExtents.x)[i];
+        float    c    = proj < -he ? -he : (proj > he ? he : proj);
+        closest = XMVectorMultiplyAdd(ax, XMVectorReplicate(c), closest);
+    }
+    XMFLOAT3 out;
+    XMStoreFloat3(&out, closest);
+    return out;
+}
+
+// ---- sphere casts -----------------------------------------------------------
+// A sphere of the given radius moves from ray.origin along ray.direction.
+// t is the distance travelled to first touch; normal points from the surface
+// towards the sphere centre. A sphere that starts touching reports t = 0 only
+// if it is moving into the surface, so sliding along or away is never blocked.
+
+// Sphere cast vs Sphere — ray vs the target grown by radius.
+inline bool SphereCast(const Ray& ray, float radius, const Sphere& s,
+                       float& t, DirectX::XMFLOAT3& normal)
+{
+    using namespace DirectX;
+    XMVECTOR oc  = XMVectorSubtract(XMLoadFloat3(&ray.origin), XMLoadFloat3(&s.center));
+    XMVECTOR dir = XMLoadFloat3(&ray.direction);
+    float    r   = radius + s.radius;
+    float    b   = XMVectorGetX(XMVector3Dot(oc, dir));
+    float    c   = XMVectorGetX(XMVector3Dot(oc, oc)) - r * r;
+
+    if (b >= 0.0f) return false;              // moving away (or already overlapping and separating)
+    if (c <= 0.0f) t = 0.0f;
+    else
+    {
+        float disc = b * b - c;
+        if (disc < 0.0f) return false;
+        t = -b - sqrtf(disc);
+    }
+    XMVECTOR hitCenter = XMVectorMultiplyAdd(dir, XMVectorReplicate(t), XMLoadFloat3(&ray.origin));
+    XMStoreFloat3(&normal, XMVector3Normalize(XMVectorSubtract(hitCenter, XMLoadFloat3(&s.center))));
+    return true;
+}
+
+// Sphere cast vs Plane — front side only.
+inline bool SphereCast(const Ray& ray, float radius, const Plane& plane,
+                       float& t, DirectX::XMFLOAT3& normal)
+{
+    using namespace DirectX;
+    float dist  = plane.SignedDistance(ray.origin);
+    float denom = XMVectorGetX(XMVector3Dot(XMLoadFloat3(&ray.direction), XMLoadFloat3(&plane.normal)));
+
+    if (dist < 0.0f || denom >= -1e-8f) return false; // behind, parallel or moving away
+    t = dist <= radius ? 0.0f : (radius - dist) / denom;
+    normal = plane.normal;
+    return true;
+}
+
+// Sphere cast vs any convex shape given its closest-point function, by
+// conservative advancement: the gap to the shape is a safe step along the ray.
+// A convex shape can only be hit while the ray heads towards its closest point,
+// which makes misses exit early.
+template<typename ClosestFn>
+inline bool SphereCastConvex(const Ray& ray, float radius, float tMax, ClosestFn&& closestPoint,
+                             float& t, DirectX::XMFLOAT3& normal)
+{
+    using namespace DirectX;
+    const float    tolerance = 1e-4f;
+    const XMVECTOR origin    = XMLoadFloat3(&ray.origin);
+    const XMVECTOR dir       = XMLoadFloat3(&ray.direction);
+
+    t = 0.0f;
+    for (int i = 0; i < 32; ++i)
+    {
+        XMVECTOR c     = XMVectorMultiplyAdd(dir, XMVectorReplicate(t), origin);
+        XMFLOAT3 cf;
+        XMStoreFloat3(&cf, c);
+        XMFLOAT3 q     = closestPoint(cf);
+        XMVECTOR delta = XMVectorSubtract(c, XMLoadFloat3(&q));
+        float    dist  = XMVectorGetX(XMVector3Length(delta));
+        float    gap   = dist - radius;
+
+        if (XMVectorGetX(XMVector3Dot(dir, delta)) >= 0.0f) return false; // moving away
+        if (gap <= tolerance)
+        {
+            XMStoreFloat3(&normal, dist > 1e-6f ? XMVectorScale(delta, 1.0f / dist)
+                                                : XMVectorNegate(dir));
+            return true;
+        }
+        t += gap;
+        if (t > tMax) return false;
+    }
+    return false; // still approaching at a grazing angle — treat as a miss
+}
+
+// Sphere cast vs OBB.
+inline bool SphereCast(const Ray& ray, float radius, const OBB& obb, float tMax,
+                       float& t, DirectX::XMFLOAT3& normal)
+{
+    return SphereCastConvex(ray, radius, tMax,
+        [&](const DirectX::XMFLOAT3& p) { return ClosestPoint(obb, p); }, t, normal);
+}
+
 } // namespace SE
@@ -1,6 +1,7 @@
 #pragma once
 #include <DirectXMath.h>
 #include <cmath>
+#include "Engine/Physics/AABB.h"
 
 namespace SE {
 
@@ -22,6 +23,16 @@ struct OBB
             XMVectorSet(center.x, center.y, center.z, 1.0f));
     }
 
+    // Tight world-space AABB enclosing this OBB.
+    AABB GetAABB() const
+    {
+        DirectX::XMFLOAT3 e;
+        e.x = fabsf(axes[0].x) * halfExtents.x + fabsf(axes[1].x) * halfExtents.y + fabsf(axes[2].x) * halfExtents.z;
+        e.y = fabsf(axes[0].y) * halfExtents.x + fabsf(axes[1].y) * halfExtents.y + fabsf(axes[2].y) * halfExtents.z;
+        e.z = fabsf(axes[0].z) * halfExtents.x + fabsf(axes[1].z) * halfExtents.y + fabsf(axes[2].z) * halfExtents.z;
+        return AABB::FromCenterExtents(center, e);
+    }
+
     // Axis-aligned OBB from min/max corners.
     static OBB FromAABB(DirectX::XMFLOAT3 mn, DirectX::XMFLOAT3 mx)
     {
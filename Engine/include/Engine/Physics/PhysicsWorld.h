@@ -1,9 +1,16 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <vector>
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Physics/AABB.h"
+#include "Engine/Physics/Broadphase.h"
+#include "Engine/Physics/BVH.h"
 #include "Engine/Physics/Plane.h"
 #include "Engine/Physics/Ray.h"
 #include "Engine/Physics/Sphere.h"
 #include "Engine/Physics/OBB.h"
+#include "Engine/Physics/TriangleMesh.h"
 #include "Engine/Physics/CharacterController.h"
 #include "Engine/Scene/TransformComponent.h"
 #include "Engine/Physics/RigidBodyComponent.h"
@@ -34,9 +41,17 @@ public:
         float friction    = 0.4f;
     };
 
+    // Shared so several worlds (or a world rebuilt on scene reload) can reuse one cooked mesh.
+    struct StaticTriangleMesh
+    {
+        std::shared_ptr<const TriangleMesh> mesh;
+        float restitution = 0.5f;
+        float friction    = 0.4f;
+    };
+
     struct RaycastHit
     {
-        enum class Kind { Sphere, Plane, OBB };
+        enum class Kind { Sphere, Plane, OBB, TriangleMesh };
 
         float               t         = 0.0f;
         DirectX::XMFLOAT3   point     = {};
@@ -45,30 +60,272 @@ public:
         Kind                kind      = Kind::Plane;
     };
 
+    // Narrowphase work done by the last Step(); the broadphase is what keeps these low.
+    struct StepStats
+    {
+        uint32_t bodies      = 0;
+        uint32_t spherePairs = 0; // sphere-vs-sphere pairs tested
+        uint32_t staticPairs = 0; // sphere-vs-OBB/plane/triangle pairs tested
+        uint32_t contacts    = 0; // contacts fed to the solver
+        uint32_t islands     = 0; // independent contact groups solved in parallel
+        uint32_t ccdBodies   = 0; // bodies fast enough to be swept instead of stepped
+        uint32_t ccdHits     = 0; // times of impact found by those sweeps
+        uint32_t sleeping    = 0; // bodies asleep after the step
+    };
+
+    PhysicsWorld();
+
+    // Swap the dynamic broadphase (default: SweepAndPruneBroadphase).
+    void SetBroadphase(std::unique_ptr<Broadphase> broadphase);
+    // Cell size of the static-OBB spatial hash; roughly the size of a typical static box.
+    void SetStaticCellSize(float cellSize);
+
+    const StepStats& GetLastStepStats() const { return m_stats; }
+
+    // Solves contact islands, parallel ray batches and the broadphase pair
+    // search as jobs on a shared job system, e.g. the Engine's; nullptr (the
+    // default) runs them inline. Results are identical for any thread count:
+    // islands share no bodies and each one is solved in a fixed order.
+    void     SetJobSystem(JobSystem* jobs);
+    // The job system's threads, 1 without one.
+    uint32_t GetThreadCount() const { return m_jobs ? m_jobs->GetThreadCount() : 1u; }
+
+    // Sequential-impulse iterations per island: velocity solve, then position correction.
+    void SetSolverIterations(uint32_t velocityIterations, uint32_t positionIterations);
+
+    // Sweep bodies that move more than half their radius in a step, so they
+    // can't tunnel through thin geometry (on by default).
+    void SetContinuousCollision(bool enabled) { m_continuousCollision = enabled; }
+    bool GetContinuousCollision() const       { return m_continuousCollision; }
+
+    // Let resting bodies sleep (on by default). Turning it off wakes them all.
+    void SetSleepEnabled(bool enabled) { m_sleepEnabled = enabled; }
+    bool GetSleepEnabled() const       { return m_sleepEnabled; }
+
+    // Fixed-step driver. Simulate(frameDt) adds the frame time to an accumulator
+    // and runs Step(fixedStep) once per whole step it holds, so the simulation
+    // only ever sees one dt and its results don't depend on the frame rate.
+    // At most maxSubsteps run per call; time beyond that is dropped so a slow
+    // frame can't snowball into ever longer ones.
+    // seconds must be > 0; anything else is rejected (and asserts).
+    void     SetFixedTimeStep(float seconds, uint32_t maxSubsteps = 8);
+    float    GetFixedTimeStep() const { return m_fixedTimeStep; }
+    uint32_t Simulate(float frameDt); // returns the number of steps run
+    uint64_t GetTickCount() const     { return m_tickCount; }
+
+    // Fraction of a step left in the accumulator, [0, 1). Rendering a body at
+    // lerp(previousPosition, position, alpha) hides the step/frame mismatch.
+    float             GetInterpolationAlpha() const { return m_accumulator / m_fixedTimeStep; }
+    DirectX::XMFLOAT3 GetInterpolatedPosition(const TransformComponent& t, const RigidBodyComponent& rb) const;
+
+    // Rollback for replays and correction checks. Snapshot writes the whole
+    // simulation state to out, reusing its capacity: sphere bodies (read through
+    // their components), static planes and OBBs, the solver's warm-start cache,
+    // the fixed-step clock and, if given, a character. Restore writes it back.
+    // Triangle meshes are shared and immutable, so they are only checked, as are
+    // the sphere bodies' count. A snapshot that doesn't fit this world is
+    // rejected before anything changes.
+    void Snapshot(std::vector<uint8_t>& out, const CharacterController* cc = nullptr) const;
+    bool Restore(const std::vector<uint8_t>& data, CharacterController* cc = nullptr);
+
+    // Runs ticks fixed steps now, as Simulate would, e.g. straight after Restore.
+    // Steps reuse the world's scratch buffers, so replaying doesn't allocate once
+    // they have grown to size.
+    void Resimulate(uint32_t ticks);
+
+    // The world takes over integration of rb (see Step) and wakes it.
     void AddSphere     (TransformComponent* t, RigidBodyComponent* rb, float radius);
     void AddStaticPlane(Plane plane, float restitution = 0.5f, float friction = 0.4f);
+    // O(1): static OBBs are indexed in a BVH that is rebuilt once, lazily, on the
+    // next Step/StepCharacter (or RebuildStaticBVH), so a level's worth of adds
+    // costs a single build. Until then, unindexed OBBs are tested linearly.
     void AddStaticOBB  (OBB obb,    float restitution = 0.5f, float friction = 0.4f);
+    // Level geometry. The mesh carries its own BVH, so adding one is O(1).
+    void AddStaticTriangleMesh(std::shared_ptr<const TriangleMesh> mesh,
+                               float restitution = 0.5f, float friction = 0.4f);
     void Clear();
 
+    // Move an existing static OBB (e.g. a door). Call RefitStaticBVH() after a batch
+    // of moves — refit keeps the tree topology, so it is O(n) with no re-sort.
+    void     SetStaticOBB(uint32_t index, const OBB& obb);
+    uint32_t GetStaticOBBCount() const { return static_cast<uint32_t>(m_staticOBBs.size()); }
+
+    void RebuildStaticBVH();
+    void RefitStaticBVH();
+    const BVH& GetStaticBVH() const { return m_staticBVH; }
+
     // Returns true and fills hit with the closest intersection along ray.
     bool Raycast(const Ray& ray, RaycastHit& hit) const;
 
-    // Move a character capsule with gravity + collision response (planes and static OBBs).
+    // Raycast for many rays per call: hits[i] is what Raycast(rays[i]) reports,
+    // or t = FLT_MAX on a miss. Spheres, planes and static OBBs are tested four
+    // rays at a time with SIMD, triangle meshes one ray at a time. With parallel
+    // set, chunks of rays are spread over the job system, so call it from one
+    // thread at a time. Returns the number of rays that hit.
+    uint32_t RaycastBatch(const Ray* rays, uint32_t count, RaycastHit* hits, bool parallel = false) const;
+
+    // Sweeps a sphere of radius along ray for up to maxDist and fills hit with the
+    // first touch. hit.point is the contact point, hit.t the distance travelled.
+    bool SphereCast(const Ray& ray, float radius, float maxDist, RaycastHit& hit) const;
+
+    // Closest point on any static plane, OBB or triangle mesh within maxDist of p.
+    bool ClosestStaticPoint(DirectX::XMFLOAT3 p, float maxDist, DirectX::XMFLOAT3& closest) const;
+
+    // Move a character capsule with gravity + collision response (planes, static OBBs and triangle meshes).
     // wishVel is the desired horizontal velocity (not yet multiplied by dt).
     void StepCharacter(CharacterController& cc, DirectX::XMFLOAT3 wishVel, float dt);
 
-    // Collision detection + impulse resolution only.
-    // Call AFTER Scene::Update() so integration has already run.
+    // Integrates every awake sphere body, gathers contacts, splits them into
+    // islands and solves each island with warm-started sequential impulses.
+    // Sleeping bodies are obstacles only: they are not integrated, pairs of two
+    // sleepers are never generated, and a moving body that reaches one wakes it.
+    // Body state is copied out of the components once at the start and written
+    // back to the transforms/components once at the end.
     void Step(float dt);
 
 private:
+    // Packed per-body simulation state, indexed like m_spheres.
+    struct BodyArrays
+    {
+        std::vector<DirectX::XMFLOAT4A> position;    // xyz, w = radius
+        std::vector<DirectX::XMFLOAT4A> velocity;    // xyz, w = 0
+        std::vector<DirectX::XMFLOAT4A> accel;       // force / mass + gravity, w = 0
+        std::vector<float>              invMass;     // 0 = static
+        std::vector<float>              restitution;
+        std::vector<float>              friction;
+        std::vector<uint8_t>            dynamic;     // enabled && !isStatic
+
+        void Resize(size_t count);
+    };
+
+    static constexpr uint32_t k_NoBody = ~0u;
+
+    struct Contact
+    {
+        uint32_t          a;
+        uint32_t          b;              // k_NoBody = static surface
+        uint64_t          key;            // identity across steps, for warm starting
+        DirectX::XMFLOAT3 normal;         // unit, pointing towards a
+        DirectX::XMFLOAT3 point;          // static contacts: closest point on the surface
+        float             separation;     // at generation; > 0 = speculative (not yet touching)
+        float             restitution;
+        float             friction;
+        float             bias;           // target separating speed (restitution)
+        float             normalImpulse;  // accumulated, >= 0
+        DirectX::XMFLOAT3 tangentImpulse; // accumulated, |t| <= friction * normalImpulse
+    };
+
+    struct CachedImpulse
+    {
+        uint64_t          key;
+        float             normalImpulse;
+        DirectX::XMFLOAT3 tangentImpulse;
+    };
+
+    struct SweepHit
+    {
+        float             t;
+        DirectX::XMFLOAT3 normal;
+        float             restitution;
+        RaycastHit::Kind  kind;
+    };
+
+    // Contacts m_islandContacts[first, first + count).
+    struct Island
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+
     std::vector<SphereBody>  m_spheres;
+    BodyArrays               m_bodies;
     std::vector<StaticPlane> m_planes;
     std::vector<StaticOBB>   m_staticOBBs;
+    std::vector<StaticTriangleMesh> m_triMeshes;
+
+    std::unique_ptr<Broadphase> m_broadphase;
+    StaticSpatialHash           m_staticHash;
+    bool                        m_staticDirty = true;
+    StepStats                   m_stats;
+
+    // Static OBBs [0, m_bvhPrimCount) are in the tree; the rest are tested linearly.
+    BVH                         m_staticBVH;
+    std::vector<AABB>           m_staticBounds;
+    uint32_t                    m_bvhPrimCount = 0;
+    bool                        m_bvhNeedsRefit = false;
+
+    // Per-step scratch, kept to avoid reallocating every frame.
+    std::vector<AABB>           m_sphereBounds;
+    std::vector<BroadphasePair> m_pairs;
+    std::vector<uint32_t>       m_candidates;
+    std::vector<const TriangleMesh::Triangle*> m_triCandidates;
+    std::vector<uint32_t>       m_fastBodies;
+    std::vector<BroadphasePair> m_sweepPairs;
+    std::vector<uint8_t>        m_sleepReady;
+
+    // Solver state. m_warmStart is last step's impulses, sorted by key.
+    std::vector<Contact>        m_contacts;
+    std::vector<CachedImpulse>  m_warmStart;
+    std::vector<Island>         m_islands;
+    std::vector<uint32_t>       m_islandContacts;
+    std::vector<uint32_t>       m_islandOrder;   // dispatch order, largest island first
+    std::vector<uint32_t>       m_islandParent;  // union-find over bodies
+    std::vector<uint32_t>       m_islandOfBody;  // island id by union-find root
+    std::vector<uint32_t>       m_contactIsland; // island id by contact
+    JobSystem*                  m_jobs = nullptr;
+    uint32_t                    m_velocityIterations = 8;
+    uint32_t                    m_positionIterations = 2;
+    bool                        m_continuousCollision = true;
+    bool                        m_sleepEnabled        = true;
+
+    float                       m_fixedTimeStep = 1.0f / 60.0f;
+    uint32_t                    m_maxSubsteps   = 8;
+    float                       m_accumulator   = 0.0f;
+    uint64_t                    m_tickCount     = 0;
+
+    // One fixed step for Simulate / Resimulate.
+    void Tick();
+
+    void GatherBodies();
+    void GatherBody(uint32_t i);
+    void IntegrateVelocities(float dt);
+    void IntegratePositions(float dt);
+    void ScatterBodies();
+
+    // Fast bodies skipped by IntegratePositions are moved here, one time of
+    // impact at a time, against static geometry and the other spheres.
+    void SweepFastBodies(float dt);
+    // RaycastBatch for up to RayPacket4::k_Width rays.
+    uint32_t RaycastPacket(const Ray* rays, uint32_t count, RaycastHit* hits) const;
+
+    // Closest static hit with t < hit.t (the caller seeds hit.t with the sweep length).
+    bool SweepStatic(const Ray& ray, float radius, SweepHit& hit) const;
+
+    void RebuildStaticHash();
+    void UpdateSphereBounds(float margin);
+    void UpdateStaticBVH();
+
+    // Sorted indices of static OBBs whose bounds overlap box (BVH + unindexed tail).
+    void GatherStaticOBBs(const AABB& box, std::vector<uint32_t>& out) const;
+
+    // Contact generation on m_bodies; i, a, b index m_spheres.
+    void CollideSphereVsPlane (uint32_t i, uint32_t planeIndex);
+    void CollideSphereVsSphere(uint32_t a, uint32_t b);
+    // Contact against the closest point on a static surface, if within the radius.
+    void CollideSphereVsPoint (uint32_t i, const DirectX::XMFLOAT3& closest, uint64_t key,
+                               float restitution, float friction);
+
+    // Wakes sleeping bodies that a moving body is about to touch (within the
+    // speculative margin) and gathers them in for this step.
+    void WakeTouchedBodies(float dt);
+    // Counts rest steps and puts whole islands to sleep once all their bodies rested.
+    void UpdateSleep();
 
-    void ResolveSphereVsPlane (SphereBody& s, const StaticPlane& p);
-    void ResolveSphereVsSphere(SphereBody& a, SphereBody& b);
-    void ResolveSphereVsOBB   (SphereBody& s, const StaticOBB& o);
+    void ApplyWarmStart();
+    void BuildIslands();
+    void SolveIslandVelocities(const Island& island, float dt);
+    void SolveIslandPositions(const Island& island);
+    void StoreWarmStart();
 };
 
 } // namespace SE
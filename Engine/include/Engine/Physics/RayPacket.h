@@ -0,0 +1,143 @@
+#pragma once
+#include <cfloat>
+#include <cstdint>
+#include <DirectXMath.h>
+#include "Engine/Physics/AABB.h"
+#include "Engine/Physics/OBB.h"
+#include "Engine/Physics/Plane.h"
+#include "Engine/Physics/Ray.h"
+#include "Engine/Physics/Sphere.h"
+
+namespace SE {
+
+// Four rays in SoA form: lane i of every vector belongs to ray i, so one
+// XMVECTOR op advances all four. Unused lanes repeat the last ray, which keeps
+// them numerically harmless; callers ignore their results.
+struct RayPacket4
+{
+    static constexpr uint32_t k_Width = 4;
+
+    DirectX::XMVECTOR ox, oy, oz; // origins
+    DirectX::XMVECTOR dx, dy, dz; // normalised directions
+
+    static RayPacket4 Load(const Ray* rays, uint32_t count)
+    {
+        using namespace DirectX;
+        XMFLOAT4A o[3], d[3];
+        for (uint32_t i = 0; i < k_Width; ++i)
+        {
+            const Ray& r = rays[i < count ? i : count - 1];
+            (&o[0].x)[i] = r.origin.x;    (&o[1].x)[i] = r.origin.y;    (&o[2].x)[i] = r.origin.z;
+            (&d[0].x)[i] = r.direction.x; (&d[1].x)[i] = r.direction.y; (&d[2].x)[i] = r.direction.z;
+        }
+        RayPacket4 p;
+        p.ox = XMLoadFloat4A(&o[0]); p.oy = XMLoadFloat4A(&o[1]); p.oz = XMLoadFloat4A(&o[2]);
+        p.dx = XMLoadFloat4A(&d[0]); p.dy = XMLoadFloat4A(&d[1]); p.dz = XMLoadFloat4A(&d[2]);
+        return p;
+    }
+};
+
+// ---- packet versions of the Intersects(Ray, …) routines --------------------
+// Same maths as Intersect.h, one ray per lane. Each returns a lane mask (all
+// bits set = hit) and writes t for the hit lanes; other lanes of t are junk.
+
+// Ray packet vs Sphere — as Intersects(Ray, Sphere, t).
+inline DirectX::XMVECTOR Intersects(const RayPacket4& p, const Sphere& s, DirectX::XMVECTOR& t)
+{
+    using namespace DirectX;
+    XMVECTOR ocx = XMVectorSubtract(p.ox, XMVectorReplicate(s.center.x));
+    XMVECTOR ocy = XMVectorSubtract(p.oy, XMVectorReplicate(s.center.y));
+    XMVECTOR ocz = XMVectorSubtract(p.oz, XMVectorReplicate(s.center.z));
+
+    XMVECTOR a = XMVectorMultiplyAdd(p.dz, p.dz, XMVectorMultiplyAdd(p.dy, p.dy, XMVectorMultiply(p.dx, p.dx)));
+    XMVECTOR b = XMVectorMultiplyAdd(ocz, p.dz, XMVectorMultiplyAdd(ocy, p.dy, XMVectorMultiply(ocx, p.dx)));
+    b          = XMVectorAdd(b, b);
+    XMVECTOR c = XMVectorMultiplyAdd(ocz, ocz, XMVectorMultiplyAdd(ocy, ocy, XMVectorMultiply(ocx, ocx)));
+    c          = XMVectorSubtract(c, XMVectorReplicate(s.radius * s.radius));
+
+    XMVECTOR disc = XMVectorNegativeMultiplySubtract(XMVectorScale(a, 4.0f), c, XMVectorMultiply(b, b));
+    XMVECTOR hit  = XMVectorGreaterOrEqual(disc, XMVectorZero());
+    XMVECTOR sq   = XMVectorSqrt(XMVectorMax(disc, XMVectorZero()));
+    XMVECTOR a2   = XMVectorAdd(a, a);
+
+    XMVECTOR tNear = XMVectorDivide(XMVectorSubtract(XMVectorNegate(b), sq), a2);
+    XMVECTOR tFar  = XMVectorDivide(XMVectorAdd(XMVectorNegate(b), sq), a2);
+    t = XMVectorSelect(tNear, tFar, XMVectorLess(tNear, XMVectorZero())); // origin inside: far root
+    return XMVectorAndInt(hit, XMVectorGreaterOrEqual(t, XMVectorZero()));
+}
+
+// Ray packet vs Plane — as Intersects(Ray, Plane, t).
+inline DirectX::XMVECTOR Intersects(const RayPacket4& p, const Plane& plane, DirectX::XMVECTOR& t)
+{
+    using namespace DirectX;
+    XMVECTOR nx = XMVectorReplicate(plane.normal.x);
+    XMVECTOR ny = XMVectorReplicate(plane.normal.y);
+    XMVECTOR nz = XMVectorReplicate(plane.normal.z);
+
+    XMVECTOR denom = XMVectorMultiplyAdd(p.dz, nz, XMVectorMultiplyAdd(p.dy, ny, XMVectorMultiply(p.dx, nx)));
+    XMVECTOR num   = XMVectorSubtract(XMVectorReplicate(plane.d),
+        XMVectorMultiplyAdd(p.oz, nz, XMVectorMultiplyAdd(p.oy, ny, XMVectorMultiply(p.ox, nx))));
+
+    t = XMVectorDivide(num, denom);
+    return XMVectorAndInt(XMVectorGreaterOrEqual(XMVectorAbs(denom), XMVectorReplicate(1e-8f)),
+                          XMVectorGreaterOrEqual(t, XMVectorZero()));
+}
+
+// Ray packet vs OBB — as Intersects(Ray, OBB, t); slab test in OBB space.
+// The face normal is left to the scalar routine, run once for the winning lane.
+inline DirectX::XMVECTOR Intersects(const RayPacket4& p, const OBB& obb, DirectX::XMVECTOR& t)
+{
+    using namespace DirectX;
+    XMVECTOR relX = XMVectorSubtract(p.ox, XMVectorReplicate(obb.center.x));
+    XMVECTOR relY = XMVectorSubtract(p.oy, XMVectorReplicate(obb.center.y));
+    XMVECTOR relZ = XMVectorSubtract(p.oz, XMVectorReplicate(obb.center.z));
+
+    XMVECTOR tMin = XMVectorZero();
+    XMVECTOR tMax = XMVectorReplicate(FLT_MAX);
+    XMVECTOR ok   = XMVectorTrueInt();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const XMFLOAT3& ax = obb.axes[i];
+        XMVECTOR axX = XMVectorReplicate(ax.x), axY = XMVectorReplicate(ax.y), axZ = XMVectorReplicate(ax.z);
+        XMVECTOR e   = XMVectorMultiplyAdd(relZ, axZ, XMVectorMultiplyAdd(relY, axY, XMVectorMultiply(relX, axX)));
+        XMVECTOR f   = XMVectorMultiplyAdd(p.dz, axZ, XMVectorMultiplyAdd(p.dy, axY, XMVectorMultiply(p.dx, axX)));
+        XMVECTOR he  = XMVectorReplicate((&obb.halfExtents.x)[i]);
+
+        // Parallel lanes only need the origin inside the slab.
+        XMVECTOR slab   = XMVectorGreater(XMVectorAbs(f), XMVectorReplicate(1e-8f));
+        XMVECTOR inside = XMVectorLessOrEqual(XMVectorAbs(e), he);
+        ok = XMVectorAndInt(ok, XMVectorOrInt(slab, inside));
+
+        XMVECTOR t1   = XMVectorDivide(XMVectorSubtract(XMVectorNegate(he), e), f);
+        XMVECTOR t2   = XMVectorDivide(XMVectorSubtract(he, e), f);
+        tMin = XMVectorSelect(tMin, XMVectorMax(tMin, XMVectorMin(t1, t2)), slab);
+        tMax = XMVectorSelect(tMax, XMVectorMin(tMax, XMVectorMax(t1, t2)), slab);
+    }
+
+    t = tMin;
+    return XMVectorAndInt(ok, XMVectorLessOrEqual(tMin, tMax));
+}
+
+// Slab test of the packet against an AABB, given 1 / direction per lane.
+// Returns the entry distance per lane; lanes that miss (or enter beyond tMax)
+// get FLT_MAX.
+inline DirectX::XMVECTOR PacketEntry(const RayPacket4& p, const DirectX::XMVECTOR invD[3],
+                                     const AABB& b, DirectX::FXMVECTOR tMax)
+{
+    using namespace DirectX;
+    XMVECTOR tx0 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(b.min.x), p.ox), invD[0]);
+    XMVECTOR tx1 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(b.max.x), p.ox), invD[0]);
+    XMVECTOR ty0 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(b.min.y), p.oy), invD[1]);
+    XMVECTOR ty1 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(b.max.y), p.oy), invD[1]);
+    XMVECTOR tz0 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(b.min.z), p.oz), invD[2]);
+    XMVECTOR tz1 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(b.max.z), p.oz), invD[2]);
+
+    XMVECTOR tNear = XMVectorMax(XMVectorMax(XMVectorMin(tx0, tx1), XMVectorMin(ty0, ty1)),
+                                 XMVectorMax(XMVectorMin(tz0, tz1), XMVectorZero()));
+    XMVECTOR tFar  = XMVectorMin(XMVectorMin(XMVectorMax(tx0, tx1), XMVectorMax(ty0, ty1)),
+                                 XMVectorMin(XMVectorMax(tz0, tz1), tMax));
+    return XMVectorSelect(XMVectorReplicate(FLT_MAX), tNear, XMVectorLessOrEqual(tNear, tFar));
+}
+
+} // namespace SE
@@ -1,11 +1,16 @@
 #pragma once
+#include <cstdint>
 #include <DirectXMath.h>
 #include "Engine/Scene/Component.h"
 
 namespace SE {
 
+struct TransformComponent;
+
 struct RigidBodyComponent : Component
 {
+    static constexpr float kGravity = -9.81f;
+
     float mass       = 1.0f;
     bool  isStatic   = false;
     bool  useGravity = true;
@@ -16,11 +21,33 @@ struct RigidBodyComponent : Component
     DirectX::XMFLOAT3 velocity = { 0.0f, 0.0f, 0.0f };
     DirectX::XMFLOAT3 force    = { 0.0f, 0.0f, 0.0f }; // accumulated; cleared after each step
 
-    // Sustained force applied over time (F = ma).
+    // Set by PhysicsWorld::AddSphere. The world integrates the body inside Step,
+    // so Update() leaves it alone.
+    bool simulatedByWorld = false;
+
+    // Transform position before the last fixed step, kept by PhysicsWorld::Simulate
+    // for interpolation. Set it along with the position when teleporting a body.
+    DirectX::XMFLOAT3 previousPosition = { 0.0f, 0.0f, 0.0f };
+
+    // Sleep state, maintained by PhysicsWorld. A body that stays slower than the
+    // sleep speed for enough consecutive steps stops being simulated until it is
+    // hit by a moving body or pushed through AddForce / AddImpulse.
+    bool     canSleep  = true;
+    bool     sleeping  = false;
+    uint32_t restSteps = 0; // consecutive slow steps
+
+    void WakeUp() { sleeping = false; restSteps = 0; }
+
+    // Sustained force applied over time (F = ma). Wakes the body.
     void AddForce(DirectX::XMFLOAT3 f);
-    // Instantaneous velocity change, independent of mass.
+    // Instantaneous velocity change, independent of mass. Wakes the body.
     void AddImpulse(DirectX::XMFLOAT3 impulse);
 
+    // Gravity, accumulated force and one semi-implicit Euler step into t, for
+    // bodies the world doesn't simulate. Touches only this body and t, so it
+    // can run from a parallel system.
+    void Integrate(TransformComponent& t, float dt);
+
     void Update(float dt) override;
 };
 
@@ -0,0 +1,60 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Engine/Physics/AABB.h"
+#include "Engine/Physics/BVH.h"
+#include "Engine/Physics/Ray.h"
+
+namespace SE {
+
+// World-space triangle soup with a BVH, used as static level collision.
+// Triangles are stored in BVH leaf order so a leaf's triangles sit together.
+class TriangleMesh
+{
+public:
+    struct Triangle
+    {
+        DirectX::XMFLOAT3 v0, v1, v2;
+
+        float MaxY() const { return fmaxf(v0.y, fmaxf(v1.y, v2.y)); }
+    };
+
+    // Copies the indexed geometry (transformed by world) and builds the BVH.
+    // Degenerate triangles are dropped.
+    void Build(const DirectX::XMFLOAT3* positions, uint32_t vertexCount,
+               const uint32_t* indices, uint32_t indexCount,
+               DirectX::FXMMATRIX world = DirectX::XMMatrixIdentity());
+
+    // Closest two-sided hit with t < tMax. normal faces back along the ray.
+    bool Raycast(const Ray& ray, float tMax, float& t, DirectX::XMFLOAT3& normal) const;
+
+    // Closest two-sided touch for a sphere of radius moving along ray, t < tMax.
+    // normal points from the triangle towards the sphere centre.
+    bool SphereCast(const Ray& ray, float radius, float tMax, float& t, DirectX::XMFLOAT3& normal) const;
+
+    // Closest point on any triangle within maxDist of p.
+    bool ClosestPoint(DirectX::XMFLOAT3 p, float maxDist, DirectX::XMFLOAT3& closest) const;
+
+    // Calls fn(const Triangle&) for every triangle in a leaf overlapping box.
+    template<typename Fn>
+    void QueryAABB(const AABB& box, Fn&& fn) const
+    {
+        m_bvh.QueryAABB(box, [&](uint32_t i) { fn(m_triangles[i]); });
+    }
+
+    const AABB& GetBounds()        const { return m_bounds; }
+    uint32_t    GetTriangleCount() const { return static_cast<uint32_t>(m_triangles.size()); }
+    const BVH&  GetBVH()           const { return m_bvh; }
+    const std::vector<Triangle>& GetTriangles() const { return m_triangles; }
+
+    static DirectX::XMFLOAT3 ClosestPointOnTriangle(const DirectX::XMFLOAT3& p, const Triangle& tri);
+
+private:
+    std::vector<Triangle> m_triangles;
+    BVH                   m_bvh;
+    AABB                  m_bounds;
+};
+
+} // namespace SE
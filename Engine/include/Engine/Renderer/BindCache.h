@@ -0,0 +1,177 @@
+#pragma once
+#include <d3d11.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "Engine/Core/Logger.h"
+
+namespace SE {
+
+struct BindStats
+{
+    uint32_t issued  = 0;   // calls that reached the context (binds and uploads)
+    uint32_t skipped = 0;   // calls dropped because the state was already current
+};
+
+// Remembers what was last bound through it on one context and drops calls
+// that would set the same thing again: pixel shader SRVs and samplers,
+// VS/PS constant buffers, rasterizer and blend state, and cbuffer contents
+// (an upload whose bytes match the previous one is skipped).
+//
+// State bound behind its back is invisible to it, so Reset() before using
+// it again after other code has touched the context. Context is any type
+// with ID3D11DeviceContext's methods of the same names, so the tracking can
+// be driven by a recording mock without a device.
+template<typename Context = ID3D11DeviceContext>
+class BindCache
+{
+public:
+    static constexpr uint32_t k_SRVSlots     = 16;
+    static constexpr uint32_t k_SamplerSlots = 4;
+    static constexpr uint32_t k_CBSlots      = 8;
+    static constexpr uint32_t k_Uploads      = 8;   // distinct cbuffers whose contents are tracked
+
+    // Forget all bindings and contents; the next call for each issues.
+    void Reset()
+    {
+        m_srvs.Reset();
+        m_samplers.Reset();
+        m_vsCBs.Reset();
+        m_psCBs.Reset();
+        m_rsKnown    = false;
+        m_blendKnown = false;
+        for (Upload& u : m_uploads) u.buffer = nullptr;
+    }
+
+    void SetPSShaderResource(Context* ctx, uint32_t slot, ID3D11ShaderResourceView* srv)
+    {
+        if (Track(m_srvs, slot, srv)) ctx->PSSetShaderResources(slot, 1, &srv);
+    }
+
+    void SetPSSampler(Context* ctx, uint32_t slot, ID3D11SamplerState* sampler)
+    {
+        if (Track(m_samplers, slot, sampler)) ctx->PSSetSamplers(slot, 1, &sampler);
+    }
+
+    void SetVSConstantBuffer(Context* ctx, uint32_t slot, ID3D11Buffer* buffer)
+    {
+        if (Track(m_vsCBs, slot, buffer)) ctx->VSSetConstantBuffers(slot, 1, &buffer);
+    }
+
+    void SetPSConstantBuffer(Context* ctx, uint32_t slot, ID3D11Buffer* buffer)
+    {
+        if (Track(m_psCBs, slot, buffer)) ctx->PSSetConstantBuffers(slot, 1, &buffer);
+    }
+
+    void SetRasterizerState(Context* ctx, ID3D11RasterizerState* rs)
+    {
+        if (Count(!m_rsKnown || m_rs != rs))
+        {
+            ctx->RSSetState(rs);
+            m_rs      = rs;
+            m_rsKnown = true;
+        }
+    }
+
+    // Zero blend factor, all samples.
+    void SetBlendState(Context* ctx, ID3D11BlendState* blend)
+    {
+        if (Count(!m_blendKnown || m_blend != blend))
+        {
+            const float factor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            ctx->OMSetBlendState(blend, factor, 0xFFFFFFFF);
+            m_blend      = blend;
+            m_blendKnown = true;
+        }
+    }
+
+    // Writes data into a dynamic cbuffer (map / discard) unless it already
+    // holds exactly these bytes. Returns whether it uploaded.
+    bool UpdateConstants(Context* ctx, ID3D11Buffer* buffer, const void* data, uint32_t size)
+    {
+        Upload& u = FindUpload(buffer);
+        const bool same = u.buffer == buffer && u.bytes.size() == size
+                       && std::memcmp(u.bytes.data(), data, size) == 0;
+        if (!Count(!same)) return false;
+
+        D3D11_MAPPED_SUBRESOURCE mapped = {};
+        SE_HR(ctx->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped));
+        if (!mapped.pData)
+        {
+            u.buffer = nullptr;
+            return false;
+        }
+        std::memcpy(mapped.pData, data, size);
+        ctx->Unmap(buffer, 0);
+
+        u.buffer = buffer;
+        u.bytes.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        return true;
+    }
+
+    const BindStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = {}; }
+
+private:
+    template<typename T, uint32_t N>
+    struct Slots
+    {
+        T        bound[N] = {};
+        uint32_t known    = 0;   // bit per slot
+        void Reset() { known = 0; }
+    };
+
+    struct Upload
+    {
+        ID3D11Buffer*        buffer = nullptr;
+        std::vector<uint8_t> bytes;
+    };
+
+    bool Count(bool issue)
+    {
+        ++(issue ? m_stats.issued : m_stats.skipped);
+        return issue;
+    }
+
+    // Slots past the tracked range always issue.
+    template<typename T, uint32_t N>
+    bool Track(Slots<T, N>& s, uint32_t slot, T value)
+    {
+        if (slot >= N) return Count(true);
+        const uint32_t bit = 1u << slot;
+        if (!Count(!(s.known & bit) || s.bound[slot] != value)) return false;
+        s.bound[slot] = value;
+        s.known      |= bit;
+        return true;
+    }
+
+    // The entry for buffer, else a free one, else the first (evicted).
+    Upload& FindUpload(ID3D11Buffer* buffer)
+    {
+        Upload* vacant = nullptr;
+        for (Upload& u : m_uploads)
+        {
+            if (u.buffer == buffer) return u;
+            if (!u.buffer && !vacant) vacant = &u;
+        }
+        if (!vacant)
+        {
+            vacant = &m_uploads[0];
+            vacant->buffer = nullptr;
+        }
+        return *vacant;
+    }
+
+    Slots<ID3D11ShaderResourceView*, k_SRVSlots>  m_srvs;
+    Slots<ID3D11SamplerState*, k_SamplerSlots>    m_samplers;
+    Slots<ID3D11Buffer*, k_CBSlots>               m_vsCBs;
+    Slots<ID3D11Buffer*, k_CBSlots>               m_psCBs;
+    ID3D11RasterizerState* m_rs         = nullptr;
+    ID3D11BlendState*      m_blend      = nullptr;
+    bool                   m_rsKnown    = false;
+    bool                   m_blendKnown = false;
+    Upload                 m_uploads[k_Uploads];
+    BindStats              m_stats;
+};
+
+} // namespace SE
@@ -3,9 +3,12 @@
 #include <DirectXMath.h>
 #include <wrl/client.h>
 #include <cstdint>
+#include <vector>
 #include "Engine/Renderer/ConstantBuffer.h"
+#include "Engine/Renderer/Frustum.h"
 #include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Renderer/Mesh.h"
+#include "Engine/Renderer/VisibilityIndex.h"
 #include "Engine/Renderer/VertexBuffer.h"
 #include "Engine/Renderer/IndexBuffer.h"
 
@@ -27,6 +30,11 @@ public:
     // Render shadow depth for a single cascade.
     void BeginCascade(ID3D11DeviceContext* ctx, int cascade);
     void DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, DirectX::XMMATRIX model);
+    void DrawSubMeshes(ID3D11DeviceContext* ctx, const Mesh& mesh, DirectX::XMMATRIX model,
+                       const uint32_t* subMeshes, uint32_t count);
+    // Every caster submesh in the index that touches the current cascade's
+    // caster volume (see GetCasterFrustum).
+    void DrawCasters(ID3D11DeviceContext* ctx, const VisibilityIndex& index);
     void DrawSphere(ID3D11DeviceContext* ctx, DirectX::XMFLOAT3 position, float radius);
     void EndCascade(ID3D11DeviceContext* ctx);
 
@@ -37,6 +45,11 @@ public:
     // For backwards compat with LightCB (uses cascade 0 as primary)
     DirectX::XMMATRIX GetLightViewProj() const { return m_cascadeVP[0]; }
 
+    // The cascade's ortho box with its near plane dropped, so it reaches back
+    // to the light: anything between the light and the cascade can shadow it.
+    const Frustum& GetCasterFrustum(int cascade) const { return m_casterFrustum[cascade]; }
+    const VisibilityIndex::CasterStats& GetCasterStats(int cascade) const { return m_casterStats[cascade]; }
+
     // Public tuning parameters
     float splitLambda = 0.75f;  // PSSM lambda (0=linear, 1=logarithmic)
 
@@ -58,6 +71,10 @@ private:
 
     DirectX::XMMATRIX m_cascadeVP[CSM_NUM_CASCADES] = {};
     float             m_splits[CSM_NUM_CASCADES + 1] = {};
+    Frustum           m_casterFrustum[CSM_NUM_CASCADES] = {};
+
+    VisibilityIndex::CasterStats m_casterStats[CSM_NUM_CASCADES];
+    std::vector<uint32_t>        m_casters;   // DrawCasters query scratch
 
     Microsoft::WRL::ComPtr<ID3D11Texture2D>           m_depthTex;
     Microsoft::WRL::ComPtr<ID3D11DepthStencilView>    m_dsv[CSM_NUM_CASCADES];
@@ -77,6 +94,8 @@ private:
     ID3D11RenderTargetView* m_savedRTV = nullptr;
     ID3D11DepthStencilView* m_savedDSV = nullptr;
     ID3D11RasterizerState*  m_savedRS  = nullptr;
+
+    void BindModel(ID3D11DeviceContext* ctx, DirectX::XMMATRIX model);
 };
 
 } // namespace SE
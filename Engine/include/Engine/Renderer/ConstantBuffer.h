@@ -57,6 +57,8 @@ public:
         ctx->CSSetConstantBuffers(slot, 1, m_buffer.GetAddressOf());
     }
 
+    ID3D11Buffer* GetBuffer() const { return m_buffer.Get(); }
+
 private:
     ComPtr<ID3D11Buffer> m_buffer;
 };
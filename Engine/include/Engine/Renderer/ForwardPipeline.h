@@ -4,6 +4,8 @@
 #include <wrl/client.h>
 #include <vector>
 #include "Engine/Assets/AssetManager.h"
+#include "Engine/Core/FrameArena.h"
+#include "Engine/Renderer/BindCache.h"
 #include "Engine/Renderer/VertexBuffer.h"
 #include "Engine/Renderer/IndexBuffer.h"
 #include "Engine/Renderer/ConstantBuffer.h"
@@ -15,6 +17,8 @@
 
 namespace SE {
 
+class VisibilityIndex;
+
 class ForwardPipeline
 {
 public:
@@ -29,13 +33,16 @@ public:
         float     alphaCutoff = 0.5f;
     };
 
-    bool Init(ID3D11Device* device, AssetManager& assets, ShaderLibrary& shaders);
+    // Queued draws for a frame are kept in frameArena.
+    bool Init(ID3D11Device* device, AssetManager& assets, ShaderLibrary& shaders, FrameArena& frameArena);
 
     // Build per-submesh texture handles from asset cache; falls back to default 1x1 textures.
+    // Touches no pipeline state, so loader threads may call it.
     std::vector<SubMat> LoadMeshMaterials(AssetManager& assets, const Mesh& mesh);
 
     // Bind shaders + shared pipeline state; cache view/proj for this frame.
     // Also binds a default ForwardShadowCB (b4) with zero point shadow casters.
+    // Call every frame: the draw queue lives in the frame arena and is rebuilt here.
     void Begin(ID3D11DeviceContext* ctx, DirectX::XMMATRIX view, DirectX::XMMATRIX proj);
 
     // Bind equirectangular HDR panorama for IBL (t4). Pass nullptr to unbind.
@@ -57,6 +64,8 @@ public:
     // Submit a mesh for sorted draw. Call Flush() after all submits to actually draw.
     void SubmitMesh(const Mesh& mesh, DirectX::XMMATRIX model,
                     const std::vector<SubMat>& mats, bool transparent = false);
+    // Submit whatever in the index intersects the camera frustum, per submesh.
+    void SubmitVisible(const VisibilityIndex& index);
     void Flush(ID3D11DeviceContext* ctx);
 
     // --- Immediate rendering (legacy) ---
@@ -95,6 +104,10 @@ public:
                       DirectX::XMFLOAT3 emissiveColor = { 1.f, 1.f, 1.f });
 
     uint32_t GetLastDrawCalls() const { return m_lastDrawCalls; }
+    // State and upload calls the last Flush issued / skipped as redundant.
+    const BindStats& GetLastBindStats() const { return m_binds.GetStats(); }
+    // Submeshes queued / frustum-culled by SubmitMesh since the last Begin.
+    uint32_t GetLastVisibleCount() const { return m_lastVisible; }
     uint32_t GetLastCulledCount() const { return m_lastCulled; }
 
 private:
@@ -118,6 +131,8 @@ private:
         float emissiveIntensity; DirectX::XMFLOAT3 emissiveColor;
     };
 
+    static void SetSortState(RenderItem& item, const Mesh& mesh, const SubMat& mat);
+
     // Stored per-submit for Flush() to reference.
     struct QueuedDraw
     {
@@ -154,11 +169,17 @@ private:
     DirectX::XMMATRIX m_view = {};
     DirectX::XMMATRIX m_proj = {};
     Frustum                  m_frustum;
+    AABBSoA                  m_cullBounds;  // SubmitMesh scratch, reused across submits
+    std::vector<uint8_t>     m_cullVisible;
+    std::vector<uint32_t>    m_visibleProxies; // SubmitVisible scratch
 
+    FrameArena*              m_frameArena = nullptr;
     RenderQueue              m_queue;
-    std::vector<QueuedDraw>  m_queuedDraws;
+    ArenaVector<QueuedDraw>  m_queuedDraws;
+    BindCache<>              m_binds;         // Flush's redundant-state filter
     uint32_t                 m_lastDrawCalls = 0;
     uint32_t                 m_lastCulled    = 0;
+    uint32_t                 m_lastVisible   = 0;
 };
 
 } // namespace SE
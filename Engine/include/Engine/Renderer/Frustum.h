@@ -1,6 +1,8 @@
 #pragma once
+#include <cstdint>
 #include <DirectXMath.h>
 #include "Engine/Physics/AABB.h"
+#include "Engine/Physics/AABBSoA.h"
 
 namespace SE {
 
@@ -62,6 +64,84 @@ struct Frustum
         }
         return true;
     }
+
+    // TestAABB that also tells fully-inside boxes apart, for tree traversal:
+    // Inside when the vertex least in each plane's direction is in front of it.
+    Containment Classify(const AABB& aabb) const
+    {
+        Containment result = Containment::Inside;
+        for (int i = 0; i < 6; ++i)
+        {
+            const DirectX::XMFLOAT4& p = planes[i];
+            const float px = p.x >= 0.0f ? aabb.max.x : aabb.min.x;
+            const float py = p.y >= 0.0f ? aabb.max.y : aabb.min.y;
+            const float pz = p.z >= 0.0f ? aabb.max.z : aabb.min.z;
+            if (p.x * px + p.y * py + p.z * pz + p.w < 0.0f)
+                return Containment::Outside;
+            const float nx = p.x >= 0.0f ? aabb.min.x : aabb.max.x;
+            const float ny = p.y >= 0.0f ? aabb.min.y : aabb.max.y;
+            const float nz = p.z >= 0.0f ? aabb.min.z : aabb.max.z;
+            if (p.x * nx + p.y * ny + p.z * nz + p.w < 0.0f)
+                result = Containment::Partial;
+        }
+        return result;
+    }
+
+    // Tests boxes.count boxes four at a time: visible[i] is set to 1 if box i
+    // is at least partially inside, else 0. Returns the number visible. Same
+    // answer as TestAABB, written centre/extents-wise so every plane is one
+    // multiply-add chain per lane group.
+    uint32_t TestAABBs(const AABBSoA& boxes, uint8_t* visible) const
+    {
+        using namespace DirectX;
+        XMVECTOR n[6][3], an[6][3], d[6];
+        for (int p = 0; p < 6; ++p)
+        {
+            n[p][0]  = XMVectorReplicate(planes[p].x);
+            n[p][1]  = XMVectorReplicate(planes[p].y);
+            n[p][2]  = XMVectorReplicate(planes[p].z);
+            an[p][0] = XMVectorAbs(n[p][0]);
+            an[p][1] = XMVectorAbs(n[p][1]);
+            an[p][2] = XMVectorAbs(n[p][2]);
+            d[p]     = XMVectorReplicate(planes[p].w);
+        }
+
+        uint32_t numVisible = 0;
+        for (uint32_t i = 0; i < boxes.count; i += AABBSoA::k_Lanes)
+        {
+            const XMVECTOR cx = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&boxes.cx[i]));
+            const XMVECTOR cy = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&boxes.cy[i]));
+            const XMVECTOR cz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&boxes.cz[i]));
+            const XMVECTOR ex = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&boxes.ex[i]));
+            const XMVECTOR ey = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&boxes.ey[i]));
+            const XMVECTOR ez = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&boxes.ez[i]));
+
+            // Outside a plane when the centre's distance plus the box's
+            // projected radius is still negative.
+            XMVECTOR inside = XMVectorTrueInt();
+            for (int p = 0; p < 6; ++p)
+            {
+                XMVECTOR dist = XMVectorMultiplyAdd(cx, n[p][0], d[p]);
+                dist = XMVectorMultiplyAdd(cy, n[p][1], dist);
+                dist = XMVectorMultiplyAdd(cz, n[p][2], dist);
+                dist = XMVectorMultiplyAdd(ex, an[p][0], dist);
+                dist = XMVectorMultiplyAdd(ey, an[p][1], dist);
+                dist = XMVectorMultiplyAdd(ez, an[p][2], dist);
+                inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(dist, XMVectorZero()));
+            }
+
+            uint32_t lanes[4];
+            XMStoreInt4(lanes, inside);
+            const uint32_t n4 = boxes.count - i < AABBSoA::k_Lanes ? boxes.count - i : AABBSoA::k_Lanes;
+            for (uint32_t l = 0; l < n4; ++l)
+            {
+                const bool in  = lanes[l] != 0;
+                visible[i + l] = static_cast<uint8_t>(in);
+                numVisible    += in ? 1u : 0u;
+            }
+        }
+        return numVisible;
+    }
 };
 
 } // namespace SE
@@ -3,9 +3,11 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <DirectXMath.h>
 #include "Engine/Renderer/VertexBuffer.h"
 #include "Engine/Renderer/IndexBuffer.h"
 #include "Engine/Physics/AABB.h"
+#include "Engine/Physics/AABBSoA.h"
 
 namespace SE {
 
@@ -37,7 +39,9 @@ struct SubMeshInfo
 class Mesh
 {
 public:
-    bool Load(ID3D11Device* device, const char* path);
+    // keepCPUGeometry also keeps the merged positions/indices below; only
+    // meshes used for collision need them.
+    bool Load(ID3D11Device* device, const char* path, bool keepCPUGeometry = false);
     void Draw(ID3D11DeviceContext* ctx) const;
     void DrawSubMesh(ID3D11DeviceContext* ctx, uint32_t index) const;
 
@@ -45,6 +49,15 @@ public:
     SubMeshInfo      GetSubMeshInfo(uint32_t index) const;
     const std::string& GetDirectory() const { return m_directory; }
     const AABB&      GetBounds() const { return m_bounds; }
+    // Object-space bounds of each submesh, in submesh order.
+    const AABBSoA&   GetSubMeshBounds() const { return m_subMeshBounds; }
+
+    // Object-space positions/indices of all submeshes merged into one list,
+    // kept on the CPU for collision (TriangleMesh::Build). Empty unless
+    // loaded with keepCPUGeometry.
+    bool HasCPUGeometry() const { return !m_cpuIndices.empty(); }
+    const std::vector<DirectX::XMFLOAT3>& GetCPUPositions() const { return m_cpuPositions; }
+    const std::vector<uint32_t>&          GetCPUIndices()   const { return m_cpuIndices; }
 
 private:
     struct SubMesh
@@ -61,6 +74,10 @@ private:
     std::vector<SubMesh> m_subMeshes;
     std::string          m_directory;
     AABB                 m_bounds;
+    AABBSoA              m_subMeshBounds;
+
+    std::vector<DirectX::XMFLOAT3> m_cpuPositions;
+    std::vector<uint32_t>          m_cpuIndices;
 };
 
 } // namespace SE
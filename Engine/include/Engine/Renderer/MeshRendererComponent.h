@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Engine/Renderer/ForwardPipeline.h"
+#include "Engine/Scene/Component.h"
+
+namespace SE {
+
+// Draws a mesh at its entity's TransformComponent. The material list (one
+// SubMat per submesh) is shared by every instance of a prefab, so it is held
+// by pointer and must outlive the component. visibilityId is the entity's
+// object in the renderer's VisibilityIndex, assigned when it is first indexed.
+struct MeshRendererComponent : Component
+{
+    AssetHandle<Mesh>                           mesh;
+    const std::vector<ForwardPipeline::SubMat>* materials    = nullptr;
+    bool                                        castShadow   = true;
+    uint32_t                                    visibilityId = UINT32_MAX;
+};
+
+} // namespace SE
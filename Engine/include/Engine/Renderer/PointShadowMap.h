@@ -2,9 +2,12 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <wrl/client.h>
+#include <vector>
 #include "Engine/Renderer/ConstantBuffer.h"
+#include "Engine/Renderer/Frustum.h"
 #include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Renderer/Mesh.h"
+#include "Engine/Renderer/VisibilityIndex.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -26,9 +29,17 @@ public:
     void BeginFace(ID3D11DeviceContext* ctx, int face,
                    DirectX::XMFLOAT3 lightPos, float lightFar);
     void DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, DirectX::XMMATRIX model);
+    // Only the listed submeshes, e.g. a VisibilityIndex query result.
+    void DrawSubMeshes(ID3D11DeviceContext* ctx, const Mesh& mesh, DirectX::XMMATRIX model,
+                       const uint32_t* subMeshes, uint32_t count);
+    // Caster submeshes in the index inside both this face's frustum and the
+    // light's range.
+    void DrawCasters(ID3D11DeviceContext* ctx, const VisibilityIndex& index);
     void EndFace(ID3D11DeviceContext* ctx);
 
     ID3D11ShaderResourceView* GetSRV() const { return m_srv.Get(); }
+    // From the last frame that rendered each face.
+    const VisibilityIndex::CasterStats& GetFaceStats(int face) const { return m_faceStats[face]; }
 
 private:
     struct CBData
@@ -54,8 +65,13 @@ private:
 
     // State cached from BeginFace, used by DrawMesh
     DirectX::XMMATRIX m_faceViewProj  = {};
+    Frustum           m_faceFrustum   = {};
     DirectX::XMFLOAT3 m_lightPos      = {};
     float             m_lightFar      = 1.0f;
+    int               m_face          = 0;
+
+    VisibilityIndex::CasterStats m_faceStats[6];
+    std::vector<uint32_t>        m_casters;   // DrawCasters query scratch
 
     // Saved pipeline state, restored by EndFace
     D3D11_VIEWPORT          m_savedVP  = {};
@@ -63,6 +79,8 @@ private:
     ID3D11DepthStencilView* m_savedDSV = nullptr;
     ID3D11RasterizerState*  m_savedRS  = nullptr;
 
+    void BindModel(ID3D11DeviceContext* ctx, DirectX::XMMATRIX model);
+
     // Build a left-handed view matrix for the given cube face from lightPos.
     static DirectX::XMMATRIX FaceView(DirectX::XMFLOAT3 lightPos, int face);
 };
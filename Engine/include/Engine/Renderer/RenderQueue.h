@@ -3,44 +3,96 @@
 #include <vector>
 #include <algorithm>
 #include <cstdint>
+#include "Engine/Core/FrameArena.h"
 
 namespace SE {
 
 struct RenderItem
 {
-    DirectX::XMMATRIX  model;
     uint32_t           meshIndex;     // index into an external mesh/material array
     uint32_t           subMeshIndex;
+    uint32_t           transformIndex; // into RenderQueue::Transforms(), see PushTransform
     float              sortDepth;     // camera-space Z for sorting
     bool               transparent;
+    // Sort-key state: within a pass, opaque items are grouped by these so
+    // neighbours share bindings. Hashes are fine; collisions only cost order.
+    uint8_t            pass     = 0;  // 0..3, drawn in order
+    uint8_t            state    = 0;  // 0..3, pipeline state (e.g. alpha mode)
+    uint16_t           material = 0;
+    uint16_t           mesh     = 0;
 };
 
+// Per-frame draw list. Items are small and point at a shared transform, so
+// the submeshes of one object don't each carry a matrix; Sort orders an
+// index array by packed 64-bit keys instead of moving the items.
 class RenderQueue
 {
 public:
-    void Clear() { m_items.clear(); }
+    // Empties the queue. With an arena, the new frame's items live there:
+    // storage is rebuilt at last frame's size rather than cleared, since the
+    // old buffer may sit in memory the arena is about to hand out again.
+    void Clear(LinearArena* arena = nullptr)
+    {
+        if (!arena && !m_items.get_allocator().GetArena())
+        {
+            m_items.clear();
+            m_keys.clear();
+            m_order.clear();
+            m_transforms.clear();
+            return;
+        }
+        Rebuild(m_items, arena);
+        Rebuild(m_keys, arena);
+        Rebuild(m_order, arena);
+        Rebuild(m_transforms, arena);
+    }
 
-    void Push(const RenderItem& item) { m_items.push_back(item); }
+    uint32_t PushTransform(DirectX::FXMMATRIX model)
+    {
+        m_transforms.emplace_back();
+        DirectX::XMStoreFloat4x4(&m_transforms.back(), model);
+        return static_cast<uint32_t>(m_transforms.size() - 1);
+    }
 
-    // Sort: opaque front-to-back (lower depth first), transparent back-to-front (higher depth first).
-    void Sort()
+    void Push(const RenderItem& item)
     {
-        std::sort(m_items.begin(), m_items.end(),
-            [](const RenderItem& a, const RenderItem& b)
-            {
-                if (a.transparent != b.transparent)
-                    return !a.transparent; // opaques first
-                if (a.transparent)
-                    return a.sortDepth > b.sortDepth; // back-to-front
-                return a.sortDepth < b.sortDepth;     // front-to-back
-            });
+        m_items.push_back(item);
+        m_keys.push_back(MakeKey(item));
     }
 
-    const std::vector<RenderItem>& Items() const { return m_items; }
+    // Key layout, most significant first:
+    //   opaque       pass:2 | 0 | state:2 | material:16 | mesh:16 | depth:24 | 3 spare
+    //   transparent  pass:2 | 1 | ~depth:31 | state:2 | material:16 | mesh:12
+    // Opaques group by state and fall back to front-to-back; transparents
+    // stay strictly back-to-front and only group within equal depths.
+    static uint64_t MakeKey(const RenderItem& item);
+
+    // Orders Order() by key; ties keep submission order.
+    void Sort();
+
+    const ArenaVector<RenderItem>&          Items()      const { return m_items; }
+    const ArenaVector<uint64_t>&            Keys()       const { return m_keys; }
+    const ArenaVector<uint32_t>&            Order()      const { return m_order; }
+    const ArenaVector<DirectX::XMFLOAT4X4>& Transforms() const { return m_transforms; }
     size_t Size() const { return m_items.size(); }
 
 private:
-    std::vector<RenderItem> m_items;
+    template<typename T>
+    static void Rebuild(ArenaVector<T>& v, LinearArena* arena)
+    {
+        const size_t lastSize = v.size();
+        v = ArenaVector<T>(ArenaAllocator<T>(arena));
+        v.reserve(lastSize);
+    }
+
+    ArenaVector<RenderItem>          m_items;
+    ArenaVector<uint64_t>            m_keys;
+    ArenaVector<uint32_t>            m_order;
+    ArenaVector<DirectX::XMFLOAT4X4> m_transforms;
+
+    // Radix ping-pong buffers; kept across frames so sorting doesn't allocate.
+    std::vector<uint64_t> m_keyScratch[2];
+    std::vector<uint32_t> m_orderScratch;
 };
 
 } // namespace SE
@@ -38,6 +38,7 @@ public:
 
     void BindPS(ID3D11DeviceContext* ctx, uint32_t slot) const;
     void BindVS(ID3D11DeviceContext* ctx, uint32_t slot) const;
+    ID3D11SamplerState* GetSampler() const { return m_sampler.Get(); }
 
 private:
     ComPtr<ID3D11SamplerState> m_sampler;
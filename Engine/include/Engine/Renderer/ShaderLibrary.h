@@ -40,10 +40,15 @@ public:
     void Clear();
 
 private:
-    std::string MakeKey(const std::wstring& file,
-                        const std::vector<ShaderDefine>& defines) const;
+    // Builds the cache key for (file, defines[, entry point]) into m_key,
+    // reusing its buffer, so lookups that hit the cache don't allocate.
+    const std::string& MakeKey(const std::wstring& file,
+                               const std::vector<ShaderDefine>& defines,
+                               const char* entryPoint = nullptr);
 
     ID3D11Device* m_device = nullptr;
+    std::string                      m_key;
+    std::vector<const ShaderDefine*> m_sortedDefines;
     std::unordered_map<std::string, ShaderPermutation> m_cache;
     std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D11ComputeShader>> m_csCache;
 };
@@ -2,6 +2,7 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <wrl/client.h>
+#include <utility>
 #include "Engine/Renderer/VertexBuffer.h"
 #include "Engine/Renderer/IndexBuffer.h"
 #include "Engine/Renderer/ConstantBuffer.h"
@@ -16,6 +17,12 @@ public:
     bool Init(ID3D11Device* device, RenderStateCache& cache, ShaderLibrary& shaders);
     bool LoadPanorama(ID3D11Device* device, const wchar_t* path);
 
+    // LoadPanorama in two halves: decode and upload on any thread (device
+    // only), then swap the result in on the render thread.
+    static bool LoadPanoramaSRV(ID3D11Device* device, const wchar_t* path,
+                                Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& out);
+    void SetPanorama(Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv) { m_panoramaSRV = std::move(srv); }
+
     // Strip translation from view, draw unit cube at far plane.
     void Draw(ID3D11DeviceContext* ctx, DirectX::XMMATRIX view, DirectX::XMMATRIX proj);
 
@@ -3,9 +3,11 @@
 #include <DirectXMath.h>
 #include <wrl/client.h>
 #include <cstdint>
+#include <vector>
 #include "Engine/Renderer/ConstantBuffer.h"
 #include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Renderer/Mesh.h"
+#include "Engine/Renderer/VisibilityIndex.h"
 
 namespace SE {
 
@@ -21,6 +23,11 @@ public:
     // Shadow pass: render scene depth from spot light's perspective.
     void BeginShadowPass(ID3D11DeviceContext* ctx);
     void DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, DirectX::XMMATRIX model);
+    // Only the listed submeshes, e.g. a VisibilityIndex query result.
+    void DrawSubMeshes(ID3D11DeviceContext* ctx, const Mesh& mesh, DirectX::XMMATRIX model,
+                       const uint32_t* subMeshes, uint32_t count);
+    // Caster submeshes in the index that touch the light's cone.
+    void DrawCasters(ID3D11DeviceContext* ctx, const VisibilityIndex& index);
     void EndShadowPass(ID3D11DeviceContext* ctx);
 
     // Bind spot light cbuffer (b5) and shadow map SRV (t8) for lit pass.
@@ -40,6 +47,7 @@ public:
 
     DirectX::XMMATRIX GetViewProj() const { return m_viewProj; }
     ID3D11ShaderResourceView* GetSRV() const { return m_srv.Get(); }
+    const VisibilityIndex::CasterStats& GetCasterStats() const { return m_casterStats; }
 
 private:
     struct SpotLightCBData
@@ -70,6 +78,11 @@ private:
     ConstantBuffer<ShadowCBData>     m_shadowCB;
     ConstantBuffer<SpotLightCBData>  m_lightCB;
 
+    VisibilityIndex::CasterStats m_casterStats;
+    std::vector<uint32_t>        m_casters;   // DrawCasters query scratch
+
+    void BindShadowModel(ID3D11DeviceContext* ctx, DirectX::XMMATRIX model);
+
     D3D11_VIEWPORT          m_savedVP  = {};
     ID3D11RenderTargetView* m_savedRTV = nullptr;
     ID3D11DepthStencilView* m_savedDSV = nullptr;
@@ -22,6 +22,7 @@ public:
 
     // Bind the SRV to the pixel shader.
     void BindPS(ID3D11DeviceContext* ctx, uint32_t slot) const;
+    ID3D11ShaderResourceView* GetSRV() const { return m_srv.Get(); }
 
     uint32_t GetWidth()  const { return m_width; }
     uint32_t GetHeight() const { return m_height; }
@@ -0,0 +1,156 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Engine/Physics/AABBSoA.h"
+#include "Engine/Physics/DynamicAABBTree.h"
+#include "Engine/Renderer/ForwardPipeline.h"
+#include "Engine/Renderer/Frustum.h"
+#include "Engine/Renderer/Mesh.h"
+
+namespace SE {
+
+// Render-side spatial index: one DynamicAABBTree leaf per submesh of every
+// drawable object, in world space. The camera pass (ForwardPipeline::
+// SubmitVisible) and the light passes query it instead of walking the scene,
+// so their cost follows what they can see rather than the scene size.
+//
+// Objects are added once and moved with SetTransform; the caller keeps the
+// mesh and material list alive until RemoveObject or Clear. Removed ids and
+// proxy slots are reused by later adds, so drop an id once it is removed.
+class VisibilityIndex
+{
+public:
+    static constexpr uint32_t k_Invalid = UINT32_MAX;
+
+    struct Object
+    {
+        const Mesh*                                 mesh       = nullptr; // nullptr once removed
+        const std::vector<ForwardPipeline::SubMat>* materials  = nullptr;
+        DirectX::XMFLOAT4X4                         world;
+        uint32_t                                    firstProxy = 0;       // one per submesh, in order;
+                                                                          // next free object once removed
+        bool                                        castShadow = true;
+    };
+
+    struct Proxy
+    {
+        uint32_t object;
+        uint32_t subMesh;
+        uint32_t treeId;
+        AABB     bounds; // world space
+    };
+
+    // One shadow pass's share of the casters in the index: submeshes it drew
+    // and the rest, which its volume rejected.
+    struct CasterStats
+    {
+        uint32_t drawn  = 0;
+        uint32_t culled = 0;
+    };
+
+    uint32_t AddObject(const Mesh& mesh, const std::vector<ForwardPipeline::SubMat>* materials,
+                       DirectX::FXMMATRIX world, bool castShadow = true);
+    // Cheap when the matrix hasn't changed; otherwise moves the object's
+    // proxies, which only touches the tree for those that leave their margin.
+    void SetTransform(uint32_t object, DirectX::FXMMATRIX world);
+    void RemoveObject(uint32_t object);
+    void Clear();
+
+    // Each query appends proxy indices in ascending order, so an object's
+    // submeshes are adjacent and in submesh order (see ForEachObject).
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out) const;
+    void QuerySphere(DirectX::XMFLOAT3 center, float radius, std::vector<uint32_t>& out) const;
+    // Spot light volume: apex, unit direction, range and half angle in radians.
+    void QueryCone(DirectX::XMFLOAT3 apex, DirectX::XMFLOAT3 dir, float range, float halfAngle,
+                   std::vector<uint32_t>& out) const;
+    // Any other volume: classify(const AABB&) returns its Containment.
+    template<typename Classify>
+    void Query(Classify&& classify, std::vector<uint32_t>& out) const;
+
+    static Containment ClassifySphere(const AABB& b, const DirectX::XMFLOAT3& center, float radiusSq);
+
+    // Groups a query result by object: fn(const Object&, const uint32_t*
+    // subMeshes, uint32_t count) once per object that has visible submeshes.
+    template<typename Fn>
+    void ForEachObject(const std::vector<uint32_t>& proxies, Fn&& fn) const;
+    // ForEachObject restricted to shadow casters, counted against every
+    // caster in the index.
+    template<typename Fn>
+    CasterStats ForEachCaster(const std::vector<uint32_t>& proxies, Fn&& fn) const;
+
+    const Object& GetObjectInfo(uint32_t object) const { return m_objects[object]; }
+    const Proxy&  GetProxyInfo(uint32_t proxy)  const { return m_proxies[proxy]; }
+    // Live submesh proxies, i.e. what a query could return at most.
+    uint32_t GetProxyCount() const { return m_tree.GetProxyCount(); }
+    uint32_t GetCasterCount() const { return m_casterCount; }
+    int      GetTreeHeight() const { return m_tree.GetHeight(); }
+
+private:
+    // The tree tests fat boxes; a leaf it reports is kept if its exact box passes too.
+    template<typename Classify>
+    void Collect(uint32_t leaf, Classify& classify, std::vector<uint32_t>& out) const
+    {
+        const uint32_t proxy = m_tree.GetUserData(leaf);
+        if (classify(m_proxies[proxy].bounds) != Containment::Outside)
+            out.push_back(proxy);
+    }
+
+    // Proxies freed by RemoveObject, kept as the contiguous runs they were.
+    struct ProxyRun
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    uint32_t AllocateProxies(uint32_t count);
+
+    DynamicAABBTree       m_tree;
+    std::vector<Object>   m_objects;
+    std::vector<Proxy>    m_proxies;
+    uint32_t              m_freeObjects = k_Invalid; // through Object::firstProxy
+    std::vector<ProxyRun> m_freeRuns;
+    AABBSoA               m_scratch;   // world-space submesh bounds in SetTransform
+    uint32_t              m_casterCount = 0; // live proxies of castShadow objects
+    mutable std::vector<uint32_t> m_batch; // ForEachObject's submesh list
+};
+
+template<typename Classify>
+void VisibilityIndex::Query(Classify&& classify, std::vector<uint32_t>& out) const
+{
+    const size_t first = out.size();
+    m_tree.Query(classify, [&](uint32_t leaf) { Collect(leaf, classify, out); });
+    // Tree order to proxy order, which groups each object's submeshes.
+    std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
+
+template<typename Fn>
+void VisibilityIndex::ForEachObject(const std::vector<uint32_t>& proxies, Fn&& fn) const
+{
+    size_t i = 0;
+    while (i < proxies.size())
+    {
+        const uint32_t object = m_proxies[proxies[i]].object;
+        m_batch.clear();
+        for (; i < proxies.size() && m_proxies[proxies[i]].object == object; ++i)
+            m_batch.push_back(m_proxies[proxies[i]].subMesh);
+        fn(m_objects[object], m_batch.data(), static_cast<uint32_t>(m_batch.size()));
+    }
+}
+
+template<typename Fn>
+VisibilityIndex::CasterStats VisibilityIndex::ForEachCaster(const std::vector<uint32_t>& proxies, Fn&& fn) const
+{
+    CasterStats stats;
+    ForEachObject(proxies, [&](const Object& o, const uint32_t* subMeshes, uint32_t count)
+    {
+        if (!o.castShadow) return;
+        fn(o, subMeshes, count);
+        stats.drawn += count;
+    });
+    stats.culled = m_casterCount - stats.drawn;
+    return stats;
+}
+
+} // namespace SE
@@ -0,0 +1,269 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "Engine/Core/ObjectPool.h"
+#include "Engine/Scene/Component.h"
+
+namespace SE {
+
+using EntityID = uint32_t;
+
+static constexpr EntityID k_NoEntity = 0; // Scene hands out IDs from 1
+
+// Dense per-process index for each component type, assigned on first use.
+uint32_t NextComponentTypeID();
+
+template<typename T>
+uint32_t ComponentTypeID()
+{
+    static const uint32_t id = NextComponentTypeID();
+    return id;
+}
+
+class ComponentPoolBase
+{
+public:
+    virtual ~ComponentPoolBase() = default;
+
+    virtual Component* GetBase(EntityID id) const = 0;
+    virtual void       Remove(EntityID id)        = 0;
+
+    // Update(dt) on every enabled component whose entity is active.
+    virtual void UpdateAll(float dt) = 0;
+
+    // Occupancy, counting each page as a block.
+    virtual PoolStats   GetStats()    const = 0;
+    virtual const char* GetTypeName() const = 0;
+
+    // Off once a system has taken over this type's per-frame work; the
+    // registry then skips the pool in UpdateAll / UpdateEntity.
+    void SetUpdateEnabled(bool enabled) { m_updateEnabled = enabled; }
+    bool IsUpdateEnabled() const        { return m_updateEnabled; }
+
+private:
+    bool m_updateEnabled = true;
+};
+
+// Sparse set of one component type. Components live in fixed-size pages
+// that never move, so pointers handed out stay valid until the component is
+// removed, and a pass over the pool walks whole pages of T back to back.
+// Removal leaves a hole that the next Emplace reuses; iteration skips holes.
+template<typename T>
+class ComponentPool final : public ComponentPoolBase
+{
+public:
+    static_assert(std::is_base_of<Component, T>::value, "components derive from SE::Component");
+
+    static constexpr uint32_t k_PageShift = 9;
+    static constexpr uint32_t k_PageSize  = 1u << k_PageShift; // components per page
+    static constexpr uint32_t k_NoSlot    = ~0u;
+
+    ComponentPool() = default;
+    ComponentPool(const ComponentPool&)            = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    ~ComponentPool() override
+    {
+        for (uint32_t s = 0; s < SlotCount(); ++s)
+            if (m_owners[s] != k_NoEntity) At(s)->~T();
+    }
+
+    // Constructs T for id, replacing any T it already has.
+    template<typename... Args>
+    T* Emplace(EntityID id, Args&&... args)
+    {
+        if (id >= m_sparse.size()) m_sparse.resize(id + 1, k_NoSlot);
+
+        uint32_t slot = m_sparse[id];
+        if (slot != k_NoSlot)
+        {
+            At(slot)->~T();
+            --m_count;
+        }
+        else if (!m_free.empty())
+        {
+            slot = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            slot = SlotCount();
+            if ((slot >> k_PageShift) == m_pages.size()) m_pages.push_back(std::make_unique<Page>());
+            m_owners.push_back(k_NoEntity);
+        }
+
+        T* c = new (At(slot)) T(std::forward<Args>(args)...);
+        m_sparse[id]   = slot;
+        m_owners[slot] = id;
+        ++m_count;
+        ++m_version;
+        return c;
+    }
+
+    // Makes room for count more components on entities with IDs up to
+    // maxID, so that many Emplaces don't allocate.
+    void Reserve(uint32_t count, EntityID maxID)
+    {
+        if (maxID >= m_sparse.size()) m_sparse.resize(maxID + 1, k_NoSlot);
+
+        const uint32_t fromFree = count < m_free.size() ? count : static_cast<uint32_t>(m_free.size());
+        const uint32_t slots    = SlotCount() + (count - fromFree);
+        if (slots > m_owners.capacity()) m_owners.reserve(slots > 2 * m_owners.capacity() ? slots : 2 * m_owners.capacity());
+        while (PageCount() << k_PageShift < slots) m_pages.push_back(std::make_unique<Page>());
+    }
+
+    T* Get(EntityID id) const
+    {
+        if (id >= m_sparse.size() || m_sparse[id] == k_NoSlot) return nullptr;
+        return At(m_sparse[id]);
+    }
+
+    Component* GetBase(EntityID id) const override { return Get(id); }
+
+    void Remove(EntityID id) override
+    {
+        if (id >= m_sparse.size() || m_sparse[id] == k_NoSlot) return;
+        uint32_t slot = m_sparse[id];
+        At(slot)->~T();
+        m_sparse[id]   = k_NoSlot;
+        m_owners[slot] = k_NoEntity;
+        m_free.push_back(slot);
+        --m_count;
+        ++m_version;
+    }
+
+    // Components that don't override Update are skipped outright, and the rest
+    // are called directly rather than through the vtable.
+    void UpdateAll(float dt) override
+    {
+        if constexpr (!std::is_same<decltype(&T::Update), void (Component::*)(float)>::value)
+        {
+            ForEach([dt](EntityID, T& c)
+            {
+                if (c.enabled && c.GetOwner()->active) c.T::Update(dt);
+            });
+        }
+        else
+            (void)dt;
+    }
+
+    // fn(EntityID, T&) for every live component, in slot order.
+    template<typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        ForEachInSlots(0, SlotCount(), fn);
+    }
+
+    // ForEach restricted to slots [first, last). Disjoint ranges touch
+    // disjoint components, so they can be walked on different threads.
+    template<typename Fn>
+    void ForEachInSlots(uint32_t first, uint32_t last, Fn&& fn) const
+    {
+        if (last > SlotCount()) last = SlotCount();
+        for (uint32_t s = first; s < last;)
+        {
+            T*             page    = reinterpret_cast<T*>(m_pages[s >> k_PageShift]->bytes);
+            const uint32_t pageEnd = ((s >> k_PageShift) + 1) << k_PageShift;
+            const uint32_t end     = pageEnd < last ? pageEnd : last;
+            for (; s < end; ++s)
+                if (m_owners[s] != k_NoEntity) fn(m_owners[s], page[s & (k_PageSize - 1)]);
+        }
+    }
+
+    PoolStats GetStats() const override
+    {
+        PoolStats s;
+        s.live     = m_count;
+        s.blocks   = PageCount();
+        s.capacity = s.blocks * k_PageSize;
+        s.bytes    = m_pages.size() * sizeof(Page);
+        return s;
+    }
+
+    const char* GetTypeName() const override { return typeid(T).name(); }
+
+    uint32_t Size()      const { return m_count; }
+    uint32_t SlotCount() const { return static_cast<uint32_t>(m_owners.size()); }
+    uint32_t PageCount() const { return static_cast<uint32_t>(m_pages.size()); }
+    // Changes whenever a component is added or removed.
+    uint32_t GetVersion() const { return m_version; }
+
+private:
+    struct Page
+    {
+        alignas(T) unsigned char bytes[sizeof(T) * k_PageSize];
+    };
+
+    T* At(uint32_t slot) const
+    {
+        return reinterpret_cast<T*>(m_pages[slot >> k_PageShift]->bytes) + (slot & (k_PageSize - 1));
+    }
+
+    std::vector<uint32_t>              m_sparse; // EntityID -> slot
+    std::vector<EntityID>              m_owners; // slot -> EntityID, k_NoEntity = hole
+    std::vector<uint32_t>              m_free;   // holes, reused last-in first-out
+    std::vector<std::unique_ptr<Page>> m_pages;
+    uint32_t                           m_count   = 0;
+    uint32_t                           m_version = 0;
+};
+
+// Every component pool of one Scene, indexed by ComponentTypeID. Owned through
+// a pointer so the address entities hold survives moving the Scene.
+class ComponentRegistry
+{
+public:
+    template<typename T>
+    ComponentPool<T>& Pool()
+    {
+        const uint32_t type = ComponentTypeID<T>();
+        if (type >= m_pools.size()) m_pools.resize(type + 1);
+        if (!m_pools[type]) m_pools[type] = std::make_unique<ComponentPool<T>>();
+        return static_cast<ComponentPool<T>&>(*m_pools[type]);
+    }
+
+    // nullptr if no T was ever added.
+    template<typename T>
+    ComponentPool<T>* FindPool() const
+    {
+        const uint32_t type = ComponentTypeID<T>();
+        return type < m_pools.size() ? static_cast<ComponentPool<T>*>(m_pools[type].get()) : nullptr;
+    }
+
+    template<typename T>
+    T* Get(EntityID id) const
+    {
+        ComponentPool<T>* pool = FindPool<T>();
+        return pool ? pool->Get(id) : nullptr;
+    }
+
+    // fn(const ComponentPoolBase&) for every pool, in type registration order.
+    template<typename Fn>
+    void ForEachPool(Fn&& fn) const
+    {
+        for (const auto& pool : m_pools)
+            if (pool) fn(*pool);
+    }
+
+    // Drops every component of id.
+    void RemoveAll(EntityID id);
+    // Updates pool by pool, in type registration order.
+    void UpdateAll(float dt);
+    // Updates just id's components (Entity::Update).
+    void UpdateEntity(EntityID id, float dt);
+
+    // Bumped whenever one of this scene's transforms gains or loses a
+    // parent or child, so the Scene knows to re-sort them.
+    void     BumpHierarchyVersion()      { ++m_hierarchyVersion; }
+    uint32_t GetHierarchyVersion() const { return m_hierarchyVersion; }
+
+private:
+    uint32_t                                        m_hierarchyVersion = 0; // outlives m_pools: their transforms bump it
+    std::vector<std::unique_ptr<ComponentPoolBase>> m_pools;
+};
+
+} // namespace SE
@@ -1,54 +1,71 @@
 #pragma once
 #include <cstdint>
-#include <memory>
 #include <string>
-#include <typeindex>
-#include <unordered_map>
 #include "Engine/Scene/Component.h"
+#include "Engine/Scene/ComponentPool.h"
 
 namespace SE {
 
-using EntityID = uint32_t;
+// Weak reference to an entity. The ID slot is recycled once the entity is
+// destroyed; the generation tells a stale handle from the slot's new owner.
+struct EntityHandle
+{
+    EntityID id         = k_NoEntity;
+    uint32_t generation = 0;
+
+    explicit operator bool() const { return id != k_NoEntity; }
+    bool operator==(const EntityHandle& o) const { return id == o.id && generation == o.generation; }
+    bool operator!=(const EntityHandle& o) const { return !(*this == o); }
+};
 
+// A name and an ID. Its components live in the owning Scene's per-type pools,
+// so a lookup is two array reads and no component is its own allocation.
 class Entity
 {
 public:
-    Entity(EntityID id, std::string name);
+    Entity(EntityID id, std::string name, ComponentRegistry* registry);
 
     template<typename T, typename... Args>
     T* AddComponent(Args&&... args)
     {
-        auto comp   = std::make_unique<T>(std::forward<Args>(args)...);
-        T*   ptr    = comp.get();
-        comp->m_owner = this;
-        m_components[std::type_index(typeid(T))] = std::move(comp);
+        T* ptr = m_registry->Pool<T>().Emplace(m_id, std::forward<Args>(args)...);
+        ptr->m_owner = this;
         return ptr;
     }
 
     template<typename T>
     T* GetComponent() const
     {
-        auto it = m_components.find(std::type_index(typeid(T)));
-        return it != m_components.end() ? static_cast<T*>(it->second.get()) : nullptr;
+        return m_registry->Get<T>(m_id);
     }
 
     template<typename T>
     void RemoveComponent()
     {
-        m_components.erase(std::type_index(typeid(T)));
+        if (ComponentPool<T>* pool = m_registry->FindPool<T>()) pool->Remove(m_id);
     }
 
     void Update(float dt);
 
-    EntityID           GetID()   const { return m_id; }
-    const std::string& GetName() const { return m_name; }
+    EntityID           GetID()     const { return m_id; }
+    EntityHandle       GetHandle() const { return { m_id, m_generation }; }
+    const std::string& GetName()   const { return m_name; }
+    // The owning Scene's component pools.
+    ComponentRegistry* GetRegistry() const { return m_registry; }
+
+    // Scene::DestroyEntity was called; the entity goes away at the next flush.
+    bool IsPendingDestroy() const { return m_pendingDestroy; }
 
     bool active = true;
 
 private:
-    EntityID    m_id;
-    std::string m_name;
-    std::unordered_map<std::type_index, std::unique_ptr<Component>> m_components;
+    friend class Scene;
+
+    EntityID           m_id;
+    uint32_t           m_generation     = 0;
+    bool               m_pendingDestroy = false;
+    std::string        m_name;
+    ComponentRegistry* m_registry;
 };
 
 } // namespace SE
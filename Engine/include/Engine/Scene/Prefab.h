@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <DirectXMath.h>
+#include "Engine/Scene/ComponentPool.h"
+#include "Engine/Scene/Entity.h"
+#include "Engine/Scene/TransformComponent.h"
+
+namespace SE {
+
+// Where one prefab instance goes.
+struct InstanceTransform
+{
+    DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 eulerDeg = { 0.0f, 0.0f, 0.0f };
+    float             scale    = 1.0f;
+};
+
+// Template for Scene::Instantiate: an entity name and prototype components
+// that every instance gets a copy of. Instances always get their own
+// TransformComponent from the transform they're placed with, so it isn't
+// one of the prototypes.
+class Prefab
+{
+public:
+    explicit Prefab(std::string name = "Prefab") : m_name(std::move(name)) {}
+
+    template<typename T>
+    Prefab& Add(const T& prototype = T{})
+    {
+        static_assert(std::is_base_of<Component, T>::value, "components derive from SE::Component");
+        static_assert(!std::is_same<T, TransformComponent>::value, "instances get their transform from Instantiate");
+        m_parts.push_back(std::make_unique<Part<T>>(prototype));
+        return *this;
+    }
+
+    const std::string& GetName() const { return m_name; }
+
+private:
+    friend class Scene;
+
+    struct PartBase
+    {
+        virtual ~PartBase() = default;
+        virtual uint32_t GetTypeID() const = 0;
+        virtual void Reserve(ComponentRegistry& registry, uint32_t count, EntityID maxID) const = 0;
+        virtual void AddTo(Entity& entity) const = 0;
+    };
+
+    template<typename T>
+    struct Part final : PartBase
+    {
+        explicit Part(const T& p) : prototype(p) {}
+
+        uint32_t GetTypeID() const override { return ComponentTypeID<T>(); }
+        void Reserve(ComponentRegistry& registry, uint32_t count, EntityID maxID) const override
+        {
+            registry.Pool<T>().Reserve(count, maxID);
+        }
+        void AddTo(Entity& entity) const override { entity.AddComponent<T>(prototype); }
+
+        T prototype;
+    };
+
+    std::string                            m_name;
+    std::vector<std::unique_ptr<PartBase>> m_parts;
+};
+
+// How many instances of a prefab are about to be placed, for Scene::Reserve.
+struct PrefabCount
+{
+    const Prefab* prefab = nullptr;
+    uint32_t      count  = 0;
+};
+
+} // namespace SE
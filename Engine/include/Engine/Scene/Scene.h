@@ -1,25 +1,235 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
+#include "Engine/Core/ObjectPool.h"
+#include "Engine/Scene/ComponentPool.h"
 #include "Engine/Scene/Entity.h"
+#include "Engine/Scene/Prefab.h"
+#include "Engine/Scene/SystemScheduler.h"
+#include "Engine/Scene/TransformComponent.h"
 
 namespace SE {
 
+// Entities that have every one of Ts. Each(fn) calls fn(Ts&...) walking the
+// first type's pool in storage order and looking the others up by ID, so put
+// the rarest component first. Adding or removing Ts inside fn is not allowed.
+// With activeOnly, entities that are inactive or have any of Ts disabled are
+// skipped, the same ones the per-component Update pass skips.
+template<typename... Ts>
+class SceneView
+{
+public:
+    explicit SceneView(const ComponentRegistry& registry, bool activeOnly = false)
+        : m_pools(registry.FindPool<Ts>()...), m_activeOnly(activeOnly) {}
+
+    template<typename Fn>
+    void Each(Fn&& fn) const
+    {
+        if (!(std::get<ComponentPool<Ts>*>(m_pools) && ...)) return;
+        EachInSlots(0, std::get<0>(m_pools)->SlotCount(), fn);
+    }
+
+    // Each, split into one chunk per page of the first type's pool. Chunks
+    // cover disjoint entities, so they can run on different threads.
+    uint32_t ChunkCount() const
+    {
+        if (!(std::get<ComponentPool<Ts>*>(m_pools) && ...)) return 0;
+        return std::get<0>(m_pools)->PageCount();
+    }
+
+    template<typename Fn>
+    void EachInChunk(uint32_t chunk, Fn&& fn) const
+    {
+        if (!(std::get<ComponentPool<Ts>*>(m_pools) && ...)) return;
+        using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+        const uint32_t first = chunk << ComponentPool<First>::k_PageShift;
+        EachInSlots(first, first + ComponentPool<First>::k_PageSize, fn);
+    }
+
+private:
+    template<typename Fn>
+    void EachInSlots(uint32_t first, uint32_t last, Fn& fn) const
+    {
+        using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+        std::get<0>(m_pools)->ForEachInSlots(first, last, [&](EntityID id, First&)
+        {
+            std::tuple<Ts*...> c(std::get<ComponentPool<Ts>*>(m_pools)->Get(id)...);
+            if (!(std::get<Ts*>(c) && ...)) return;
+            if (m_activeOnly && !(std::get<0>(c)->GetOwner()->active && (std::get<Ts*>(c)->enabled && ...)))
+                return;
+            fn(*std::get<Ts*>(c)...);
+        });
+    }
+
+    std::tuple<ComponentPool<Ts>*...> m_pools;
+    bool                              m_activeOnly;
+};
+
+// Which entities a system visits: by default the ones the per-component
+// Update pass would (active, every one of its components enabled), so a
+// system can take over from Update unchanged.
+enum class SystemFilter { ActiveEnabled, All };
+
+// Entities live in a slot map: an EntityID is a slot index, so lookup by ID
+// or handle is an array read, and a destroyed entity's slot is reused by the
+// next CreateEntity with a bumped generation. Entity objects come from a
+// block pool and name-index nodes are recycled, so once a scene has reached
+// its peak size, creating and destroying entities doesn't touch the heap.
 class Scene
 {
 public:
+    Scene();
+
     Entity* CreateEntity(const std::string& name = "Entity");
+
+    // count copies of prefab, one per transform, all named after it. Storage
+    // for the entities and every pool involved is reserved up front, then
+    // each instance is created and filled in a single pass with one name
+    // lookup. The new entities are the last count of GetEntities().
+    void    Instantiate(const Prefab& prefab, const InstanceTransform* transforms, uint32_t count);
+    void    Instantiate(const Prefab& prefab, const std::vector<InstanceTransform>& transforms)
+    {
+        Instantiate(prefab, transforms.data(), static_cast<uint32_t>(transforms.size()));
+    }
+
+    // Room for count more entities with components Ts, so that many
+    // CreateEntity / AddComponent<Ts> calls don't grow any storage. A level
+    // load calls it once with the level's size before creating anything.
+    template<typename... Ts>
+    void    Reserve(uint32_t count)
+    {
+        const EntityID maxID = ReserveEntities(count, count);
+        (m_registry->Pool<Ts>().Reserve(count, maxID), ...);
+    }
+    // The same for a whole level of prefab instances plus extraEntities
+    // others: each pool grows once by its total over every prefab that uses
+    // it, so the Instantiate calls that follow, in any slicing, don't grow.
+    void    Reserve(const PrefabCount* prefabs, uint32_t prefabCount, uint32_t extraEntities = 0);
+
+    // Deferred: the entity stays alive, flagged IsPendingDestroy, until
+    // FlushDestroyed, which Update runs after the component pass. Destroying
+    // twice is harmless.
     void    DestroyEntity(EntityID id);
+    void    DestroyEntity(EntityHandle handle);
+    // Frees every entity destroyed since the last flush. Raw Entity* and
+    // component pointers to them dangle afterwards; handles go stale safely.
+    void    FlushDestroyed();
+
     Entity* FindEntity(EntityID id)               const;
+    // Oldest live entity with this name, through a name index.
     Entity* FindEntity(const std::string& name)   const;
+    // nullptr once the handle's entity has been flushed.
+    Entity* Resolve(EntityHandle handle)          const;
+    bool    IsValid(EntityHandle handle)          const { return Resolve(handle) != nullptr; }
+
+    // Updates component pools one type at a time rather than entity by entity,
+    // then runs the systems, then flushes destroyed entities.
     void    Update(float dt);
 
-    const std::vector<std::unique_ptr<Entity>>& GetEntities() const { return m_entities; }
+    // Registers fn(dt, Ts&...) to run in Update over the entities that have
+    // all of Ts and pass filter. A const T is only read; extra declares any
+    // other component fn touches. The work is split by pool page and runs on
+    // the scheduler's threads next to systems it doesn't conflict with, so fn
+    // must not create or destroy entities or add or remove components.
+    template<typename... Ts, typename Fn>
+    void AddSystem(const std::string& name, Fn fn, SystemAccess extra = {},
+                   SystemFilter filter = SystemFilter::ActiveEnabled)
+    {
+        SystemScheduler::System system;
+        system.name   = name;
+        system.access = std::move(extra);
+        (system.access.Use<Ts>(), ...);
+
+        const ComponentRegistry* registry = m_registry.get();
+        system.chunkCount = [registry]
+        {
+            return SceneView<std::remove_const_t<Ts>...>(*registry).ChunkCount();
+        };
+        const bool activeOnly = filter == SystemFilter::ActiveEnabled;
+        system.run = [registry, fn, activeOnly](uint32_t chunk, float dt)
+        {
+            SceneView<std::remove_const_t<Ts>...>(*registry, activeOnly)
+                .EachInChunk(chunk, [&](auto&... c) { fn(dt, c...); });
+        };
+        m_scheduler.Add(std::move(system));
+    }
+
+    // Stops (or restarts) the per-component Update pass for T, for when a
+    // system now does that work.
+    template<typename T>
+    void SetComponentUpdates(bool enabled) { m_registry->Pool<T>().SetUpdateEnabled(enabled); }
+
+    SystemScheduler&       GetScheduler()       { return m_scheduler; }
+    const SystemScheduler& GetScheduler() const { return m_scheduler; }
+
+    // Brings every TransformComponent's cached world matrix up to date, walking
+    // the hierarchy breadth-first so parents are done before their children and
+    // each matrix is rebuilt at most once. Picks up direct writes to position /
+    // eulerDeg / scale too. Run it after anything that moves things (physics)
+    // and before rendering.
+    void    UpdateTransforms();
+
+    template<typename... Ts>
+    SceneView<Ts...> View() const { return SceneView<Ts...>(*m_registry); }
+
+    // Live entities. Creation order until something is destroyed: destroying
+    // moves the last entity into the freed place.
+    const std::vector<Entity*>& GetEntities() const { return m_live; }
+
+    // Occupancy of the entity pool and of each component type's pool, for
+    // debug UIs. fn(const ComponentPoolBase&) per pool.
+    PoolStats GetEntityPoolStats() const { return m_entityPool.GetStats(); }
+    template<typename Fn>
+    void ForEachComponentPool(Fn&& fn) const { m_registry->ForEachPool(fn); }
 
 private:
-    std::vector<std::unique_ptr<Entity>> m_entities;
-    EntityID                             m_nextID = 1;
+    struct Slot
+    {
+        Entity*  entity     = nullptr; // from m_entityPool while alive
+        uint32_t generation = 0;       // bumped when the entity is flushed
+        uint32_t liveIndex  = 0;
+        EntityID namePrev   = k_NoEntity; // same-name chain, oldest first
+        EntityID nameNext   = k_NoEntity;
+        bool     alive      = false;
+    };
+
+    struct NameChain
+    {
+        EntityID head;
+        EntityID tail;
+    };
+
+    // Grows the slots, live list and entity pool for count more entities,
+    // and the name index for names more names. Returns the highest ID they
+    // can get.
+    EntityID ReserveEntities(uint32_t count, uint32_t names);
+    // CreateEntity without the name index.
+    Entity* NewEntity(const std::string& name);
+    void LinkName(EntityID id);
+    void AppendName(EntityID id, NameChain& chain);
+    void UnlinkName(EntityID id);
+    void RebuildTransformOrder();
+
+    ObjectPool<Entity>                         m_entityPool;
+    std::vector<Slot>                          m_slots;     // [0] unused: k_NoEntity
+    std::vector<EntityID>                      m_freeSlots;
+    std::vector<Entity*>                       m_live;
+    std::vector<EntityID>                      m_pendingDestroy;
+    std::unordered_map<std::string, NameChain> m_names;
+    // Nodes of names no entity uses any more, reused for new names.
+    std::vector<std::unordered_map<std::string, NameChain>::node_type> m_spareNames;
+    std::unique_ptr<ComponentRegistry>         m_registry;
+    SystemScheduler                            m_scheduler;
+
+    // Transforms breadth-first from the roots, i.e. sorted by depth. Rebuilt
+    // when transforms are added/removed or any parent link changes.
+    std::vector<TransformComponent*>           m_transformOrder;
+    uint32_t                                   m_transformPoolVersion      = ~0u;
+    uint32_t                                   m_transformHierarchyVersion = ~0u;
 };
 
 } // namespace SE
@@ -68,6 +68,7 @@ struct SceneDescriptor
         float                ballRadius     = 1.0f;
         std::array<float, 3> characterSpawn = { 0.0f, 5.0f, 0.0f };
         bool                 gravity        = true;
+        bool                 meshCollision  = false; // collide against the scene mesh's triangles
     };
     PhysicsDesc physics;
 
@@ -112,6 +113,33 @@ struct SceneDescriptor
     };
     std::vector<SceneObject> objects;
 
+    // Prefabs: a mesh that placements put down any number of times, each
+    // copy its own entity.
+    struct PrefabDesc
+    {
+        std::string name;
+        std::string mesh;
+        float alphaCutoff = 0.0f; // as MeshEntry::alphaCutoff
+    };
+    std::vector<PrefabDesc> prefabs;
+
+    struct InstanceDesc
+    {
+        std::array<float, 3> position = { 0.f, 0.f, 0.f };
+        std::array<float, 3> rotation = { 0.f, 0.f, 0.f }; // euler degrees (pitch, yaw, roll)
+        float scale = 1.0f;
+    };
+
+    // Copies of one prefab. "instances" are listed explicitly; "scatter"
+    // adds count more at random over a box (random yaw and scale), the same
+    // for a given seed. The loader expands scatter into instances.
+    struct PlacementDesc
+    {
+        std::string prefab;
+        std::vector<InstanceDesc> instances;
+    };
+    std::vector<PlacementDesc> placements;
+
     // Particle emitters
     struct ParticleEmitterDesc
     {
@@ -8,9 +8,25 @@ namespace SE {
 class SceneLoader
 {
 public:
-    // Load a scene descriptor from a JSON file. Returns true on success.
+    // Load a scene descriptor. A .fxscene path is read as a cooked scene; for
+    // a JSON path the cooked file next to it is used instead when it is at
+    // least as new. Returns true on success.
     static bool LoadFromFile(const std::string& path, SceneDescriptor& out);
 
+    // Parse a JSON scene, ignoring any cooked copy.
+    static bool LoadJson(const std::string& path, SceneDescriptor& out);
+
+    // Cooked scenes: a versioned binary image of a SceneDescriptor, loaded with
+    // one read and bulk copies instead of per-field parsing.
+    static bool LoadCooked(const std::string& path, SceneDescriptor& out);
+    static bool SaveCooked(const SceneDescriptor& desc, const std::string& path);
+
+    // Where the cooked copy of a JSON scene lives ("foo.json" -> "foo.fxscene").
+    static std::string GetCookedPath(const std::string& jsonPath);
+
+    // Parse jsonPath and write its cooked copy.
+    static bool Cook(const std::string& jsonPath);
+
     // Scan a directory for .json scene files. Returns list of file paths.
     static std::vector<std::string> ScanSceneDirectory(const std::string& directory);
 };
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Scene/ComponentPool.h"
+
+namespace SE {
+
+// The component types a system touches, by ComponentTypeID. Two systems
+// conflict when either writes a type the other reads or writes.
+struct SystemAccess
+{
+    std::vector<uint32_t> reads;
+    std::vector<uint32_t> writes;
+
+    template<typename... Ts>
+    SystemAccess& Read()  { (reads.push_back(ComponentTypeID<Ts>()), ...);  return *this; }
+    template<typename... Ts>
+    SystemAccess& Write() { (writes.push_back(ComponentTypeID<Ts>()), ...); return *this; }
+
+    // Read for const T, Write otherwise.
+    template<typename T>
+    SystemAccess& Use()
+    {
+        if constexpr (std::is_const<T>::value) return Read<std::remove_const_t<T>>();
+        else                                   return Write<T>();
+    }
+
+    bool ConflictsWith(const SystemAccess& other) const;
+};
+
+// Runs systems in dependency order on a job system. Each system comes after
+// every earlier-added system it conflicts with; those edges form a DAG, and
+// systems are grouped into phases by longest path through it, so a phase only
+// depends on the phases before it. Within a phase, the chunks of all its
+// systems go to the job system as one batch.
+class SystemScheduler
+{
+public:
+    struct System
+    {
+        std::string  name;
+        SystemAccess access;
+        // Chunks this frame; asked once per Run.
+        std::function<uint32_t()> chunkCount;
+        // Does one chunk's work. Different chunks of the same system, and
+        // chunks of systems in the same phase, may run at the same time.
+        std::function<void(uint32_t chunk, float dt)> run;
+    };
+
+    void Add(System system);
+
+    // Runs chunks as jobs on a shared job system (e.g. the Engine's); Run
+    // should then be called from one of its threads. nullptr (the default)
+    // runs every chunk inline.
+    void     SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+    // The job system's threads, 1 without one.
+    uint32_t GetThreadCount() const { return m_jobs ? m_jobs->GetThreadCount() : 1u; }
+
+    void Run(float dt);
+
+    uint32_t      GetSystemCount()             const { return static_cast<uint32_t>(m_systems.size()); }
+    const System& GetSystem(uint32_t index)    const { return m_systems[index]; }
+    // System indices per phase, in execution order.
+    const std::vector<std::vector<uint32_t>>& GetPhases() const { return m_phases; }
+
+private:
+    struct Task
+    {
+        uint32_t system;
+        uint32_t chunk;
+    };
+
+    std::vector<System>                m_systems;
+    std::vector<uint32_t>              m_phaseOf; // per system
+    std::vector<std::vector<uint32_t>> m_phases;
+    std::vector<Task>                  m_tasks;   // current phase, reused
+    JobSystem*                         m_jobs = nullptr;
+};
+
+} // namespace SE
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <DirectXMath.h>
 #include "Engine/Scene/Component.h"
@@ -14,25 +15,63 @@ struct TransformComponent : Component
     TransformComponent*              parent   = nullptr;
     std::vector<TransformComponent*> children;
 
+    // Leaves the hierarchy: drops out of the parent's children, and the
+    // children become roots (their local transform is now their world).
+    // Touches only its own scene's state, so a retired scene may be
+    // destroyed on another thread.
+    ~TransformComponent() override;
+
     void SetParent(TransformComponent* newParent);
     void Unparent();
 
+    // Same as writing the fields, but also flags the subtree at once (see GetWorldMatrix).
+    void SetPosition(const DirectX::XMFLOAT3& p)   { position = p;   MarkDirty(); }
+    void SetRotation(const DirectX::XMFLOAT3& deg) { eulerDeg = deg; MarkDirty(); }
+    void SetScale(float s)                         { scale    = s;   MarkDirty(); }
+
+    // Flags the world matrix of this transform and every descendant for rebuild.
+    void MarkDirty() { InvalidateWorld(); }
+
+    // Cached; rebuilt only when position / eulerDeg / scale differ from the
+    // values it was last built from.
     DirectX::XMMATRIX GetLocalMatrix() const
     {
-        using namespace DirectX;
-        return XMMatrixScaling(scale, scale, scale)
-             * XMMatrixRotationRollPitchYaw(
-                   XMConvertToRadians(eulerDeg.x),
-                   XMConvertToRadians(eulerDeg.y),
-                   XMConvertToRadians(eulerDeg.z))
-             * XMMatrixTranslation(position.x, position.y, position.z);
+        if (LocalChanged()) RebuildLocal();
+        return DirectX::XMLoadFloat4x4(&m_local);
     }
 
-    // Recursively concatenates local matrix with parent chain.
-    DirectX::XMMATRIX GetWorldMatrix() const
+    // Cached local * parent world, rebuilt when dirty. This transform's own
+    // field writes are always picked up here; an ancestor's are picked up once
+    // it has been flagged — by the setters, MarkDirty, SetParent, or
+    // Scene::UpdateTransforms, which checks every transform parents-first.
+    DirectX::XMMATRIX GetWorldMatrix() const { return DirectX::XMLoadFloat4x4(&GetWorld()); }
+    const DirectX::XMFLOAT4X4& GetWorld() const;
+
+private:
+    // Bumps the owning scene's hierarchy version (SetParent / Unparent /
+    // destruction), so it knows to re-sort. Transforms without an owner
+    // belong to no scene and have nothing to tell.
+    void HierarchyChanged() const;
+
+    bool LocalChanged() const
     {
-        return parent ? GetLocalMatrix() * parent->GetWorldMatrix() : GetLocalMatrix();
+        return !m_localValid
+            || position.x != m_builtPosition.x || position.y != m_builtPosition.y || position.z != m_builtPosition.z
+            || eulerDeg.x != m_builtEuler.x    || eulerDeg.y != m_builtEuler.y    || eulerDeg.z != m_builtEuler.z
+            || scale != m_builtScale;
     }
+    void RebuildLocal() const;
+    // Invariant: a dirty transform's descendants are all dirty, so this stops
+    // at the first one that already is.
+    void InvalidateWorld() const;
+
+    mutable DirectX::XMFLOAT4X4 m_local;
+    mutable DirectX::XMFLOAT4X4 m_world;
+    mutable DirectX::XMFLOAT3   m_builtPosition = { 0.0f, 0.0f, 0.0f };
+    mutable DirectX::XMFLOAT3   m_builtEuler    = { 0.0f, 0.0f, 0.0f };
+    mutable float               m_builtScale    = 1.0f;
+    mutable bool                m_localValid    = false;
+    mutable bool                m_worldDirty    = true;
 };
 
 } // namespace SE
@@ -5,33 +5,53 @@ namespace SE {
 
 void AssetManager::Init(ID3D11Device* device, ID3D11DeviceContext* ctx)
 {
-    m_device  = device;
-    m_context = ctx;
+    m_device     = device;
+    m_context    = ctx;
+    m_mainThread = std::this_thread::get_id();
+
+    // Up front, so handing them out never needs the context.
+    m_defaultWhite  = CreateSolid(255, 255, 255);
+    m_defaultBlack  = CreateSolid(0, 0, 0);
+    m_defaultNormal = CreateSolid(128, 128, 255);
     SE_LOG_INFO("AssetManager initialised");
 }
 
-AssetHandle<Mesh> AssetManager::GetMesh(const std::string& path)
+AssetHandle<Mesh> AssetManager::GetMesh(const std::string& path, bool keepCPUGeometry)
 {
-    auto it = m_meshes.find(path);
-    if (it != m_meshes.end())
-        if (auto h = it->second.lock()) return h;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_meshes.find(path);
+        if (it != m_meshes.end())
+            if (auto h = it->second.lock())
+                if (!keepCPUGeometry || h->HasCPUGeometry()) return h;
+    }
 
     auto mesh = std::make_shared<Mesh>();
-    if (!mesh->Load(m_device, path.c_str()))
+    if (!mesh->Load(m_device, path.c_str(), keepCPUGeometry))
     {
         SE_LOG_ERROR("AssetManager: failed to load mesh '%s'", path.c_str());
         return nullptr;
     }
-    m_meshes[path] = mesh;
+
+    // Another thread may have loaded the same file meanwhile; keep the first
+    // unless it lacks the geometry asked for.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& slot = m_meshes[path];
+    if (auto h = slot.lock())
+        if (!keepCPUGeometry || h->HasCPUGeometry()) return h;
+    slot = mesh;
     SE_LOG_INFO("AssetManager: loaded mesh '%s'", path.c_str());
     return mesh;
 }
 
 AssetHandle<Texture2D> AssetManager::GetTexture(const std::wstring& path)
 {
-    auto it = m_textures.find(path);
-    if (it != m_textures.end())
-        if (auto h = it->second.lock()) return h;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_textures.find(path);
+        if (it != m_textures.end())
+            if (auto h = it->second.lock()) return h;
+    }
 
     auto tex = std::make_shared<Texture2D>();
     bool ok  = false;
@@ -41,50 +61,35 @@ AssetHandle<Texture2D> AssetManager::GetTexture(const std::wstring& path)
                  _wcsicmp(path.c_str() + path.size() - 4, L".dds") == 0;
     if (isDDS)
         ok = tex->LoadFromDDS(m_device, path.c_str());
-    else
+    else if (std::this_thread::get_id() == m_mainThread)
         ok = tex->LoadFromFile(m_device, m_context, path.c_str());
+    else
+        SE_LOG_ERROR("AssetManager: non-DDS textures load on the main thread only");
 
     if (!ok)
     {
         SE_LOG_ERROR("AssetManager: failed to load texture");
         return nullptr;
     }
-    m_textures[path] = tex;
-    return tex;
-}
 
-AssetHandle<Texture2D> AssetManager::GetDefaultWhite()
-{
-    if (auto h = m_defaultWhite.lock()) return h;
-    auto tex = std::make_shared<Texture2D>();
-    uint8_t px[4] = { 255, 255, 255, 255 };
-    tex->CreateFromMemory(m_device, m_context, px, 1, 1);
-    m_defaultWhite = tex;
-    return tex;
-}
-
-AssetHandle<Texture2D> AssetManager::GetDefaultBlack()
-{
-    if (auto h = m_defaultBlack.lock()) return h;
-    auto tex = std::make_shared<Texture2D>();
-    uint8_t px[4] = { 0, 0, 0, 255 };
-    tex->CreateFromMemory(m_device, m_context, px, 1, 1);
-    m_defaultBlack = tex;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& slot = m_textures[path];
+    if (auto h = slot.lock()) return h;
+    slot = tex;
     return tex;
 }
 
-AssetHandle<Texture2D> AssetManager::GetDefaultNormal()
+AssetHandle<Texture2D> AssetManager::CreateSolid(uint8_t r, uint8_t g, uint8_t b)
 {
-    if (auto h = m_defaultNormal.lock()) return h;
     auto tex = std::make_shared<Texture2D>();
-    uint8_t px[4] = { 128, 128, 255, 255 };
+    uint8_t px[4] = { r, g, b, 255 };
     tex->CreateFromMemory(m_device, m_context, px, 1, 1);
-    m_defaultNormal = tex;
     return tex;
 }
 
 uint32_t AssetManager::CachedMeshCount() const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     uint32_t n = 0;
     for (auto& [k, w] : m_meshes)
         if (!w.expired()) ++n;
@@ -93,6 +98,7 @@ uint32_t AssetManager::CachedMeshCount() const
 
 uint32_t AssetManager::CachedTextureCount() const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     uint32_t n = 0;
     for (auto& [k, w] : m_textures)
         if (!w.expired()) ++n;
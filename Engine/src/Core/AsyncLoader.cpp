@@ -0,0 +1,124 @@
+#include "Engine/Core/AsyncLoader.h"
+#include <chrono>
+#include <limits>
+#include <utility>
+
+namespace SE {
+
+AsyncLoader::AsyncLoader()
+{
+    // Started here, once every member the thread touches exists.
+    m_thread = std::thread([this] { WorkerMain(); });
+}
+
+AsyncLoader::~AsyncLoader()
+{
+    Shutdown();
+}
+
+void AsyncLoader::Enqueue(Work work)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) return;
+        m_work.push_back(std::move(work));
+    }
+    m_wake.notify_one();
+}
+
+void AsyncLoader::Post(Step step)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stop) return;
+    m_steps.push_back(std::move(step));
+}
+
+void AsyncLoader::Pump(double budgetMs)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+    double elapsed = 0.0;
+
+    for (;;)
+    {
+        Step step;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_steps.empty()) break;
+            step = std::move(m_steps.front());
+            m_steps.pop_front();
+        }
+
+        // Run unlocked: steps post and enqueue more. An unfinished step goes
+        // back to the front so it keeps its place.
+        const bool done = step();
+        if (!done)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_stop) m_steps.push_front(std::move(step));
+        }
+
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (elapsed >= budgetMs) break;
+    }
+    m_lastPumpMs = elapsed;
+}
+
+void AsyncLoader::Flush()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this] { return m_stop || (m_work.empty() && !m_running); });
+            if (m_stop || m_steps.empty()) return;
+        }
+        Pump(std::numeric_limits<double>::infinity());
+    }
+}
+
+void AsyncLoader::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) return;
+        m_stop = true;
+        m_work.clear();
+        m_steps.clear();
+    }
+    m_wake.notify_one();
+    m_idle.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+bool AsyncLoader::IsBusy() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running || !m_work.empty() || !m_steps.empty();
+}
+
+void AsyncLoader::WorkerMain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [this] { return m_stop || !m_work.empty(); });
+        if (m_stop) break;
+
+        Work work = std::move(m_work.front());
+        m_work.pop_front();
+        m_running = true;
+        lock.unlock();
+
+        work();
+        work = nullptr; // release captures before reporting idle
+
+        lock.lock();
+        m_running = false;
+        if (m_work.empty()) m_idle.notify_all();
+    }
+    m_running = false;
+    m_idle.notify_all();
+}
+
+} // namespace SE
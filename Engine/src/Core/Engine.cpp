@@ -6,6 +6,7 @@ bool Engine::Initialize(const WindowDesc& windowDesc)
 {
     Logger::Get().Initialize("FoxEngine.log");
     m_clock.Initialize();
+    m_jobs = std::make_unique<JobSystem>();
 
     if (!m_window.Open(windowDesc))
     {
@@ -40,7 +41,8 @@ bool Engine::Initialize(const WindowDesc& windowDesc)
         return false;
     }
 
-    SE_LOG_INFO("Engine initialised — %ux%u", windowDesc.width, windowDesc.height);
+    SE_LOG_INFO("Engine initialised — %ux%u, %u job threads",
+                windowDesc.width, windowDesc.height, m_jobs->GetThreadCount());
     return true;
 }
 
@@ -52,6 +54,9 @@ void Engine::Run()
 
     while (true)
     {
+        m_frameArena.BeginFrame();
+        const HeapCounters heapStart = GetHeapCounters();
+
         // Clear one-shot input states before pumping new messages.
         m_input.NewFrame();
         if (!m_window.PumpMessages()) break;
@@ -64,6 +69,8 @@ void Engine::Run()
 
         m_clock.Tick();
 
+        m_loader.Pump();
+
         m_renderer.BeginFrame(0.1f, 0.15f, 0.25f);
         m_imgui.BeginFrame();
         OnUpdate();
@@ -71,13 +78,20 @@ void Engine::Run()
         m_imgui.EndFrame();
         m_renderer.Present();
 
+        const HeapCounters heapEnd = GetHeapCounters();
+        m_frameMemory.heapAllocations = heapEnd.allocations - heapStart.allocations;
+        m_frameMemory.heapBytes       = heapEnd.bytes - heapStart.bytes;
+        m_frameMemory.arenaBytes      = m_frameArena.GetBytesThisFrame();
+        m_frameMemory.arenaCapacity   = m_frameArena.GetCapacity();
+
         fpsTimer += m_clock.GetDeltaTime();
         if (fpsTimer >= 1.0f)
         {
             wchar_t title[128];
-            swprintf_s(title, L"FoxEngine  |  %.1f fps  |  %.2f ms",
+            swprintf_s(title, L"FoxEngine  |  %.1f fps  |  %.2f ms  |  %llu allocs/frame",
                        m_clock.GetFPS(),
-                       m_clock.GetDeltaTime() * 1000.0f);
+                       m_clock.GetDeltaTime() * 1000.0f,
+                       m_frameMemory.heapAllocations);
             SetWindowTextW(m_window.GetHandle(), title);
             fpsTimer = 0.0f;
         }
@@ -89,9 +103,11 @@ void Engine::Run()
 
 void Engine::Shutdown()
 {
+    m_loader.Shutdown();
     m_imgui.Shutdown();
     m_renderer.Shutdown();
     m_window.Close();
+    m_jobs.reset();
     Logger::Get().Shutdown();
 }
 
@@ -0,0 +1,38 @@
+#include "Engine/Core/FrameArena.h"
+
+namespace SE {
+
+void* LinearArena::Allocate(size_t size, size_t align)
+{
+    for (;;)
+    {
+        // Skip blocks that can't take it; they get used again after Reset.
+        while (m_current < m_blocks.size())
+        {
+            Block&          block = m_blocks[m_current];
+            const uintptr_t base  = reinterpret_cast<uintptr_t>(block.data.get());
+            const size_t    start = static_cast<size_t>(((base + m_offset + align - 1) & ~(uintptr_t)(align - 1)) - base);
+            if (start + size <= block.size)
+            {
+                m_offset     = start + size;
+                m_allocated += size;
+                return block.data.get() + start;
+            }
+            ++m_current;
+            m_offset = 0;
+        }
+
+        const size_t blockSize = size + align > m_blockSize ? size + align : m_blockSize;
+        m_blocks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[blockSize]), blockSize });
+        m_capacity += blockSize;
+    }
+}
+
+void LinearArena::Reset()
+{
+    m_current   = 0;
+    m_offset    = 0;
+    m_allocated = 0;
+}
+
+} // namespace SE
@@ -0,0 +1,280 @@
+#include "Engine/Core/JobSystem.h"
+
+namespace SE {
+
+static thread_local const JobSystem* t_system = nullptr;
+static thread_local uint32_t         t_index  = JobSystem::k_NotAWorker;
+
+// Busy rounds a worker spends looking for work before it goes to sleep.
+static constexpr uint32_t k_SpinRounds = 64;
+// Ring slots AllocateJob looks at before falling back to the heap.
+static constexpr uint32_t k_RingProbes = 8;
+
+// ---- WorkDeque ---------------------------------------------------------------
+
+bool JobSystem::WorkDeque::Push(Job* job)
+{
+    const int64_t b = m_bottom.load(std::memory_order_relaxed);
+    const int64_t t = m_top.load(std::memory_order_acquire);
+    if (b - t >= k_Capacity) return false;
+
+    m_jobs[b & (k_Capacity - 1)].store(job, std::memory_order_relaxed);
+    m_bottom.store(b + 1, std::memory_order_release); // publishes the job to thieves
+    return true;
+}
+
+Job* JobSystem::WorkDeque::Pop()
+{
+    const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = m_top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        m_bottom.store(b + 1, std::memory_order_relaxed); // was empty
+        return nullptr;
+    }
+
+    Job* job = m_jobs[b & (k_Capacity - 1)].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+        // Last job: race the thieves for it.
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobSystem::WorkDeque::Steal()
+{
+    int64_t t = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = m_bottom.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+
+    Job* job = m_jobs[t & (k_Capacity - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return job;
+}
+
+// ---- JobSystem ---------------------------------------------------------------
+
+JobSystem::JobSystem(uint32_t threadCount)
+{
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        auto state  = std::make_unique<ThreadState>();
+        state->ring = std::make_unique<Job[]>(k_RingSize);
+        state->rng  = i * 2654435761u + 1;
+        m_threads.push_back(std::move(state));
+    }
+
+    t_system = this;
+    t_index  = 0;
+    for (uint32_t i = 1; i < threadCount; ++i)
+        m_workers.emplace_back(&JobSystem::WorkerMain, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    // Drain whatever is still queued so no callable is left unrun.
+    while (RunOne(Self())) {}
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit.store(true);
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers)
+        t.join();
+
+    if (t_system == this)
+    {
+        t_system = nullptr;
+        t_index  = k_NotAWorker;
+    }
+}
+
+uint32_t JobSystem::GetThreadIndex()
+{
+    return t_system ? t_index : k_NotAWorker;
+}
+
+uint32_t JobSystem::Self() const
+{
+    return t_system == this ? t_index : k_NotAWorker;
+}
+
+Job* JobSystem::AllocateJob()
+{
+    // Ring slots mostly come back in the order they went out, so the next one
+    // is usually free. Busy ones are skipped rather than waited on: the job
+    // holding one may be the one running on this very stack. A thread that
+    // keeps finding them busy has thousands of jobs queued; it gets heap jobs.
+    const uint32_t self = Self();
+    if (self != k_NotAWorker)
+    {
+        ThreadState& ts = *m_threads[self];
+        for (uint32_t tries = 0; tries < k_RingProbes; ++tries)
+        {
+            Job* job = &ts.ring[ts.next++ & (k_RingSize - 1)];
+            if (job->pending.load(std::memory_order_acquire)) continue;
+            job->pending.store(true, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    Job* job  = new Job;
+    job->heap = true;
+    return job;
+}
+
+void JobSystem::Push(Job* job)
+{
+    const uint32_t self = Self();
+    if (self == k_NotAWorker || !m_threads[self]->deque.Push(job))
+    {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        m_injected.push_back(job);
+        m_injectedCount.fetch_add(1);
+    }
+
+    m_queued.fetch_add(1);
+    if (m_sleeping.load() > 0)
+    {
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_wake.notify_one();
+    }
+}
+
+void JobSystem::Schedule(Job* job, JobCounter& dependency)
+{
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (dependency.m_value.load() != 0)
+        {
+            dependency.m_waiters.push_back(job);
+            return;
+        }
+    }
+    Push(job);
+}
+
+void JobSystem::Complete(JobCounter& counter)
+{
+    // Fast path while others are still outstanding. The last decrement goes
+    // through the lock so parking can't miss it, and so Wait can tell when
+    // this thread is done touching the counter.
+    uint32_t value = counter.m_value.load(std::memory_order_relaxed);
+    while (value > 1)
+        if (counter.m_value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            return;
+
+    std::vector<Job*> released;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        if (counter.m_value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            released.swap(counter.m_waiters);
+    }
+    for (Job* job : released)
+        Push(job);
+}
+
+void JobSystem::Execute(Job* job)
+{
+    job->invoke(*job);
+    if (job->counter) Complete(*job->counter);
+
+    if (job->heap) delete job;
+    else           job->pending.store(false, std::memory_order_release);
+}
+
+Job* JobSystem::FindJob(uint32_t self)
+{
+    if (self != k_NotAWorker)
+        if (Job* job = m_threads[self]->deque.Pop()) return job;
+
+    if (m_injectedCount.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        if (!m_injected.empty())
+        {
+            Job* job = m_injected.back();
+            m_injected.pop_back();
+            m_injectedCount.fetch_sub(1);
+            return job;
+        }
+    }
+
+    // Start at a random victim so thieves spread out.
+    const uint32_t count = static_cast<uint32_t>(m_threads.size());
+    uint32_t       start = 0;
+    if (self != k_NotAWorker)
+    {
+        uint32_t& rng = m_threads[self]->rng;
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        start = rng % count;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t victim = (start + i) % count;
+        if (victim == self) continue;
+        if (Job* job = m_threads[victim]->deque.Steal()) return job;
+    }
+    return nullptr;
+}
+
+bool JobSystem::RunOne(uint32_t self)
+{
+    Job* job = FindJob(self);
+    if (!job) return false;
+    m_queued.fetch_sub(1);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    const uint32_t self = Self();
+    while (!counter.IsDone())
+        if (!RunOne(self)) std::this_thread::yield();
+
+    // The thread that made the last decrement may still hold the lock.
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::WorkerMain(uint32_t index)
+{
+    t_system = this;
+    t_index  = index;
+
+    uint32_t idle = 0;
+    for (;;)
+    {
+        if (RunOne(index))
+        {
+            idle = 0;
+            continue;
+        }
+        if (++idle < k_SpinRounds)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleeping.fetch_add(1);
+        m_wake.wait(lock, [this] { return m_quit.load() || m_queued.load() > 0; });
+        m_sleeping.fetch_sub(1);
+        if (m_quit.load()) return;
+        idle = 0;
+    }
+}
+
+} // namespace SE
@@ -50,10 +50,13 @@ void Logger::Shutdown()
 {
     SE_LOG_INFO("Logger shutting down");
 
-    if (m_logFile)
     {
-        fclose(m_logFile);
-        m_logFile = nullptr;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_logFile)
+        {
+            fclose(m_logFile);
+            m_logFile = nullptr;
+        }
     }
 
 #ifdef SE_DEBUG
@@ -79,6 +82,8 @@ void Logger::Log(LogLevel level, const char* file, int line, const char* fmt, ..
     snprintf(line_buf, sizeof(line_buf), "[%s] %s(%d): %s\n",
              k_LevelTag[static_cast<int>(level)], file, line, msg);
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     // VS Output window.
     OutputDebugStringA(line_buf);
 
@@ -0,0 +1,90 @@
+#include "Engine/Core/MemoryStats.h"
+
+#ifndef SE_HEAP_COUNTERS
+
+namespace SE {
+
+HeapCounters GetHeapCounters()
+{
+    return {};
+}
+
+} // namespace SE
+
+#else
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The replacement operators live in the same object file as GetHeapCounters,
+// so linking the engine's frame stats pulls them in from the static library.
+
+namespace SE {
+
+static std::atomic<uint64_t> s_allocations{ 0 };
+static std::atomic<uint64_t> s_frees{ 0 };
+static std::atomic<uint64_t> s_bytes{ 0 };
+
+HeapCounters GetHeapCounters()
+{
+    HeapCounters c;
+    c.allocations = s_allocations.load(std::memory_order_relaxed);
+    c.frees       = s_frees.load(std::memory_order_relaxed);
+    c.bytes       = s_bytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+static void* CountedAlloc(size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+
+    for (;;)
+    {
+        if (void* p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+}
+
+static void CountedFree(void* p)
+{
+    if (!p) return;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+}
+
+} // namespace SE
+
+void* operator new(size_t size)
+{
+    if (void* p = SE::CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return SE::CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return SE::CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept                           { SE::CountedFree(p); }
+void operator delete[](void* p) noexcept                         { SE::CountedFree(p); }
+void operator delete(void* p, size_t) noexcept                   { SE::CountedFree(p); }
+void operator delete[](void* p, size_t) noexcept                 { SE::CountedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept    { SE::CountedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept  { SE::CountedFree(p); }
+
+#endif // SE_HEAP_COUNTERS
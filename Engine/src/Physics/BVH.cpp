@@ -0,0 +1,167 @@
+#include "Engine/Physics/BVH.h"
+#include <algorithm>
+
+namespace SE {
+
+using namespace DirectX;
+
+static void Grow(AABB& a, const AABB& b)
+{
+    a.min = { fminf(a.min.x, b.min.x), fminf(a.min.y, b.min.y), fminf(a.min.z, b.min.z) };
+    a.max = { fmaxf(a.max.x, b.max.x), fmaxf(a.max.y, b.max.y), fmaxf(a.max.z, b.max.z) };
+}
+
+static float HalfArea(const AABB& a)
+{
+    if (!a.IsValid()) return 0.0f;
+    float x = a.max.x - a.min.x, y = a.max.y - a.min.y, z = a.max.z - a.min.z;
+    return x * y + y * z + z * x;
+}
+
+void BVH::Build(const AABB* primBounds, uint32_t count)
+{
+    Clear();
+    if (count == 0) return;
+
+    m_primIndices.resize(count);
+    std::vector<XMFLOAT3> centroids(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        m_primIndices[i] = i;
+        centroids[i]     = primBounds[i].Center();
+    }
+
+    m_nodes.reserve(2 * count - 1);
+    m_nodes.push_back({ {}, 0, count });
+    Subdivide(0, 0, primBounds, centroids);
+    m_nodes.shrink_to_fit();
+}
+
+void BVH::Subdivide(uint32_t nodeIndex, uint32_t depth, const AABB* primBounds,
+                    const std::vector<XMFLOAT3>& centroids)
+{
+    const uint32_t first = m_nodes[nodeIndex].leftFirst;
+    const uint32_t count = m_nodes[nodeIndex].count;
+
+    AABB bounds, centroidBounds;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t p = m_primIndices[first + i];
+        Grow(bounds, primBounds[p]);
+        centroidBounds.Expand(centroids[p]);
+    }
+    m_nodes[nodeIndex].bounds = bounds;
+
+    if (count <= 2 || depth >= k_MaxDepth) return;
+
+    // Binned SAH: evaluate k_NumBins - 1 split planes per axis over the centroid range.
+    struct Bin { AABB bounds; uint32_t count = 0; };
+
+    int   bestAxis  = -1;
+    int   bestSplit = 0;
+    float bestCost  = FLT_MAX;
+    const float* cmin = &centroidBounds.min.x;
+    const float* cmax = &centroidBounds.max.x;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float extent = cmax[axis] - cmin[axis];
+        if (extent <= 0.0f) continue;
+        float scale = static_cast<float>(k_NumBins) / extent;
+
+        Bin bins[k_NumBins];
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t p = m_primIndices[first + i];
+            uint32_t b = static_cast<uint32_t>(((&centroids[p].x)[axis] - cmin[axis]) * scale);
+            if (b >= k_NumBins) b = k_NumBins - 1;
+            ++bins[b].count;
+            Grow(bins[b].bounds, primBounds[p]);
+        }
+
+        // Sweep from both ends to get left/right area*count for every split.
+        float    leftCost[k_NumBins - 1];
+        AABB     acc;
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < k_NumBins - 1; ++i)
+        {
+            Grow(acc, bins[i].bounds);
+            n += bins[i].count;
+            leftCost[i] = HalfArea(acc) * static_cast<float>(n);
+        }
+        acc = {};
+        n   = 0;
+        for (uint32_t i = k_NumBins - 1; i > 0; --i)
+        {
+            Grow(acc, bins[i].bounds);
+            n += bins[i].count;
+            float cost = leftCost[i - 1] + HalfArea(acc) * static_cast<float>(n);
+            if (cost < bestCost)
+            {
+                bestCost  = cost;
+                bestAxis  = axis;
+                bestSplit = static_cast<int>(i);
+            }
+        }
+    }
+
+    // Leaf if splitting doesn't beat intersecting everything here (traversal cost ~1 prim).
+    float leafCost = HalfArea(bounds) * static_cast<float>(count);
+    if (bestAxis < 0 || (count <= k_MaxLeafSize && bestCost >= leafCost)) return;
+
+    float scale = static_cast<float>(k_NumBins) / (cmax[bestAxis] - cmin[bestAxis]);
+    auto  mid   = std::partition(m_primIndices.begin() + first,
+                                 m_primIndices.begin() + first + count,
+        [&](uint32_t p)
+        {
+            uint32_t b = static_cast<uint32_t>(((&centroids[p].x)[bestAxis] - cmin[bestAxis]) * scale);
+            if (b >= k_NumBins) b = k_NumBins - 1;
+            return b < static_cast<uint32_t>(bestSplit);
+        });
+
+    uint32_t leftCount = static_cast<uint32_t>(mid - (m_primIndices.begin() + first));
+    if (leftCount == 0 || leftCount == count) return;
+
+    uint32_t left = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back({ {}, first,             leftCount });
+    m_nodes.push_back({ {}, first + leftCount, count - leftCount });
+    m_nodes[nodeIndex].leftFirst = left;
+    m_nodes[nodeIndex].count     = 0;
+
+    Subdivide(left,     depth + 1, primBounds, centroids);
+    Subdivide(left + 1, depth + 1, primBounds, centroids);
+}
+
+void BVH::Refit(const AABB* primBounds)
+{
+    for (size_t i = m_nodes.size(); i-- > 0;)
+    {
+        Node& n = m_nodes[i];
+        AABB  b;
+        if (n.IsLeaf())
+        {
+            for (uint32_t k = 0; k < n.count; ++k)
+                Grow(b, primBounds[m_primIndices[n.leftFirst + k]]);
+        }
+        else
+        {
+            b = m_nodes[n.leftFirst].bounds;
+            Grow(b, m_nodes[n.leftFirst + 1].bounds);
+        }
+        n.bounds = b;
+    }
+}
+
+void BVH::AdoptLeafOrder()
+{
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_primIndices.size()); ++i)
+        m_primIndices[i] = i;
+}
+
+void BVH::Clear()
+{
+    m_nodes.clear();
+    m_primIndices.clear();
+}
+
+} // namespace SE
@@ -0,0 +1,316 @@
+#include "Engine/Physics/Broadphase.h"
+#include "Engine/Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SE {
+
+using namespace DirectX;
+
+static bool PairLess(const BroadphasePair& x, const BroadphasePair& y)
+{
+    return x.a != y.a ? x.a < y.a : x.b < y.b;
+}
+
+// ---- Broadphase -------------------------------------------------------------
+
+void Broadphase::FindActivePairs(const uint8_t* active, std::vector<BroadphasePair>& out)
+{
+    const size_t first = out.size();
+    FindPairs(out);
+    out.erase(std::remove_if(out.begin() + first, out.end(),
+        [active](const BroadphasePair& p) { return !active[p.a] && !active[p.b]; }), out.end());
+}
+
+// ---- BruteForceBroadphase ---------------------------------------------------
+
+void BruteForceBroadphase::FindPairs(std::vector<BroadphasePair>& out)
+{
+    for (uint32_t i = 0; i < m_count; ++i)
+        for (uint32_t j = i + 1; j < m_count; ++j)
+            out.push_back({ i, j });
+}
+
+// ---- SweepAndPruneBroadphase ------------------------------------------------
+
+// b with axis moved into x. The other two stay in y and z; the overlap tests
+// treat them alike, so their order doesn't matter.
+static AABB SwapIntoX(const AABB& b, int axis)
+{
+    if (axis == 1) return { { b.min.y, b.min.x, b.min.z }, { b.max.y, b.max.x, b.max.z } };
+    if (axis == 2) return { { b.min.z, b.min.y, b.min.x }, { b.max.z, b.max.y, b.max.x } };
+    return b;
+}
+
+static bool OverlapYZ(const AABB& a, const AABB& b)
+{
+    return a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+void SweepAndPruneBroadphase::Update(const AABB* bounds, uint32_t count)
+{
+    // Body count changed (add / clear) — restart from identity order, sorted below.
+    const bool resized = m_order.size() != count;
+    if (resized)
+    {
+        m_order.resize(count);
+        for (uint32_t i = 0; i < count; ++i) m_order[i] = i;
+    }
+
+    // Centre variance per axis. Switching re-sorts from scratch, so another
+    // axis has to beat the current one by half again to take over.
+    double sum[3] = {}, sumSq[3] = {};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const XMFLOAT3 c = bounds[i].Center();
+        const double   v[3] = { c.x, c.y, c.z };
+        for (int a = 0; a < 3; ++a) { sum[a] += v[a]; sumSq[a] += v[a] * v[a]; }
+    }
+    double variance[3] = {};
+    if (count > 0)
+        for (int a = 0; a < 3; ++a)
+            variance[a] = sumSq[a] / count - (sum[a] / count) * (sum[a] / count);
+    int best = m_axis;
+    for (int a = 0; a < 3; ++a)
+        if (variance[a] > variance[best]) best = a;
+    const bool newAxis = best != m_axis && variance[best] > 1.5 * variance[m_axis];
+    if (newAxis) m_axis = best;
+
+    m_bounds.resize(count);
+    m_maxWidth = 0.0f;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        m_bounds[i] = SwapIntoX(bounds[i], m_axis);
+        m_maxWidth  = std::max(m_maxWidth, m_bounds[i].max.x - m_bounds[i].min.x);
+    }
+
+    if (newAxis || resized)
+    {
+        std::sort(m_order.begin(), m_order.end(), [this](uint32_t x, uint32_t y)
+        {
+            return m_bounds[x].min.x < m_bounds[y].min.x;
+        });
+    }
+    else
+    {
+        // Insertion sort on min: O(n + swaps), and swaps stay few frame-to-frame.
+        for (uint32_t i = 1; i < count; ++i)
+        {
+            uint32_t idx  = m_order[i];
+            float    key  = m_bounds[idx].min.x;
+            uint32_t j    = i;
+            while (j > 0 && m_bounds[m_order[j - 1]].min.x > key)
+            {
+                m_order[j] = m_order[j - 1];
+                --j;
+            }
+            m_order[j] = idx;
+        }
+    }
+
+    m_sorted.resize(count);
+    for (uint32_t i = 0; i < count; ++i) m_sorted[i] = m_bounds[m_order[i]];
+}
+
+template<typename Sweep>
+void SweepAndPruneBroadphase::SweepAll(const Sweep& sweep, std::vector<BroadphasePair>& out)
+{
+    const size_t   first = out.size();
+    const uint32_t n     = static_cast<uint32_t>(m_order.size());
+
+    JobSystem* jobs = GetJobSystem();
+    if (!jobs || n <= k_ChunkBodies)
+    {
+        for (uint32_t i = 0; i < n; ++i) sweep(i, out);
+    }
+    else
+    {
+        const uint32_t chunks = (n + k_ChunkBodies - 1) / k_ChunkBodies;
+        if (m_chunkPairs.size() < chunks) m_chunkPairs.resize(chunks);
+        jobs->ParallelFor(chunks, 1, [&](uint32_t c)
+        {
+            std::vector<BroadphasePair>& pairs = m_chunkPairs[c];
+            pairs.clear();
+            const uint32_t last = std::min(n, (c + 1) * k_ChunkBodies);
+            for (uint32_t i = c * k_ChunkBodies; i < last; ++i) sweep(i, pairs);
+        });
+        for (uint32_t c = 0; c < chunks; ++c)
+            out.insert(out.end(), m_chunkPairs[c].begin(), m_chunkPairs[c].end());
+    }
+
+    std::sort(out.begin() + first, out.end(), PairLess);
+}
+
+void SweepAndPruneBroadphase::FindPairs(std::vector<BroadphasePair>& out)
+{
+    const uint32_t n = static_cast<uint32_t>(m_order.size());
+
+    SweepAll([this, n](uint32_t i, std::vector<BroadphasePair>& pairs)
+    {
+        const AABB& a = m_sorted[i];
+        for (uint32_t j = i + 1; j < n; ++j)
+        {
+            const AABB& b = m_sorted[j];
+            if (b.min.x > a.max.x) break; // sorted: nothing further can overlap on the axis
+
+            if (OverlapYZ(a, b))
+            {
+                uint32_t ia = m_order[i], ib = m_order[j];
+                pairs.push_back(ia < ib ? BroadphasePair{ ia, ib } : BroadphasePair{ ib, ia });
+            }
+        }
+    }, out);
+}
+
+// A pair of an active and an inactive body is found from the active side:
+// scanning right as FindPairs does, or scanning left, where an overlapping box
+// starts no further back than m_maxWidth. Active-active pairs come only from
+// the right-hand scan, so nothing is reported twice.
+void SweepAndPruneBroadphase::FindActivePairs(const uint8_t* active, std::vector<BroadphasePair>& out)
+{
+    const uint32_t n = static_cast<uint32_t>(m_order.size());
+
+    SweepAll([this, n, active](uint32_t i, std::vector<BroadphasePair>& pairs)
+    {
+        const uint32_t ia = m_order[i];
+        if (!active[ia]) return;
+        const AABB& a = m_sorted[i];
+
+        for (uint32_t j = i + 1; j < n; ++j)
+        {
+            const AABB& b = m_sorted[j];
+            if (b.min.x > a.max.x) break;
+            if (OverlapYZ(a, b))
+            {
+                const uint32_t ib = m_order[j];
+                pairs.push_back(ia < ib ? BroadphasePair{ ia, ib } : BroadphasePair{ ib, ia });
+            }
+        }
+
+        for (uint32_t j = i; j-- > 0;)
+        {
+            const AABB& b = m_sorted[j];
+            if (b.min.x < a.min.x - m_maxWidth) break;
+            const uint32_t ib = m_order[j];
+            if (active[ib] || b.max.x < a.min.x) continue;
+            if (OverlapYZ(a, b))
+                pairs.push_back(ia < ib ? BroadphasePair{ ia, ib } : BroadphasePair{ ib, ia });
+        }
+    }, out);
+}
+
+void SweepAndPruneBroadphase::Clear()
+{
+    m_bounds.clear();
+    m_sorted.clear();
+    m_order.clear();
+    m_maxWidth = 0.0f;
+    m_axis     = 0;
+}
+
+// ---- StaticSpatialHash ------------------------------------------------------
+
+uint64_t StaticSpatialHash::Key(int32_t x, int32_t y, int32_t z)
+{
+    // 21 bits per axis (±1M cells) packed into one key.
+    const uint64_t mask = (1ull << 21) - 1;
+    return  (static_cast<uint64_t>(static_cast<uint32_t>(x)) & mask)
+         | ((static_cast<uint64_t>(static_cast<uint32_t>(y)) & mask) << 21)
+         | ((static_cast<uint64_t>(static_cast<uint32_t>(z)) & mask) << 42);
+}
+
+int32_t StaticSpatialHash::Cell(float v) const
+{
+    return static_cast<int32_t>(floorf(v / m_cellSize));
+}
+
+void StaticSpatialHash::Build(const AABB* bounds, uint32_t count)
+{
+    Clear();
+    m_bounds.assign(bounds, bounds + count);
+    m_stamp.assign(count, 0);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const AABB& b = m_bounds[i];
+        int32_t x0 = Cell(b.min.x), x1 = Cell(b.max.x);
+        int32_t y0 = Cell(b.min.y), y1 = Cell(b.max.y);
+        int32_t z0 = Cell(b.min.z), z1 = Cell(b.max.z);
+
+        int64_t cells = static_cast<int64_t>(x1 - x0 + 1)
+                      * static_cast<int64_t>(y1 - y0 + 1)
+                      * static_cast<int64_t>(z1 - z0 + 1);
+        if (cells > k_MaxCellsPerShape)
+        {
+            m_oversized.push_back(i);
+            continue;
+        }
+
+        for (int32_t z = z0; z <= z1; ++z)
+            for (int32_t y = y0; y <= y1; ++y)
+                for (int32_t x = x0; x <= x1; ++x)
+                    m_cells[Key(x, y, z)].push_back(i);
+    }
+}
+
+void StaticSpatialHash::Clear()
+{
+    m_bounds.clear();
+    m_cells.clear();
+    m_oversized.clear();
+    m_stamp.clear();
+    m_queryID = 0;
+}
+
+void StaticSpatialHash::Query(const AABB& box, std::vector<uint32_t>& out) const
+{
+    const size_t first = out.size();
+
+    if (++m_queryID == 0) // wrapped — reset stamps so stale ones can't match
+    {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0u);
+        m_queryID = 1;
+    }
+
+    int32_t x0 = Cell(box.min.x), x1 = Cell(box.max.x);
+    int32_t y0 = Cell(box.min.y), y1 = Cell(box.max.y);
+    int32_t z0 = Cell(box.min.z), z1 = Cell(box.max.z);
+
+    int64_t cells = static_cast<int64_t>(x1 - x0 + 1)
+                  * static_cast<int64_t>(y1 - y0 + 1)
+                  * static_cast<int64_t>(z1 - z0 + 1);
+    if (cells > static_cast<int64_t>(m_bounds.size()))
+    {
+        // Query box covers more cells than there are shapes — a flat scan is cheaper.
+        const uint32_t n = static_cast<uint32_t>(m_bounds.size());
+        for (uint32_t i = 0; i < n; ++i)
+            if (m_bounds[i].Overlaps(box))
+                out.push_back(i);
+        return;
+    }
+
+    for (uint32_t i : m_oversized)
+        if (m_bounds[i].Overlaps(box))
+            out.push_back(i);
+
+    for (int32_t z = z0; z <= z1; ++z)
+        for (int32_t y = y0; y <= y1; ++y)
+            for (int32_t x = x0; x <= x1; ++x)
+            {
+                auto it = m_cells.find(Key(x, y, z));
+                if (it == m_cells.end()) continue;
+                for (uint32_t i : it->second)
+                {
+                    if (m_stamp[i] == m_queryID) continue;
+                    m_stamp[i] = m_queryID;
+                    if (m_bounds[i].Overlaps(box))
+                        out.push_back(i);
+                }
+            }
+
+    // Keep narrowphase order deterministic regardless of hash-bucket order.
+    std::sort(out.begin() + first, out.end());
+}
+
+} // namespace SE
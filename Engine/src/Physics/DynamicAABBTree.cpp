@@ -0,0 +1,245 @@
+#include "Engine/Physics/DynamicAABBTree.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SE {
+
+static AABB Union(const AABB& a, const AABB& b)
+{
+    return { { fminf(a.min.x, b.min.x), fminf(a.min.y, b.min.y), fminf(a.min.z, b.min.z) },
+             { fmaxf(a.max.x, b.max.x), fmaxf(a.max.y, b.max.y), fmaxf(a.max.z, b.max.z) } };
+}
+
+static float HalfArea(const AABB& a)
+{
+    float x = a.max.x - a.min.x, y = a.max.y - a.min.y, z = a.max.z - a.min.z;
+    return x * y + y * z + z * x;
+}
+
+static AABB Grown(const AABB& a, float r)
+{
+    return { { a.min.x - r, a.min.y - r, a.min.z - r }, { a.max.x + r, a.max.y + r, a.max.z + r } };
+}
+
+static bool Encloses(const AABB& outer, const AABB& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+        && outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+uint32_t DynamicAABBTree::CreateProxy(const AABB& bounds, uint32_t userData)
+{
+    const uint32_t leaf = AllocateNode();
+    Node& n    = m_nodes[leaf];
+    n.bounds   = Grown(bounds, m_margin);
+    n.userData = userData;
+    n.height   = 0;
+    InsertLeaf(leaf);
+    ++m_proxyCount;
+    return leaf;
+}
+
+void DynamicAABBTree::DestroyProxy(uint32_t proxy)
+{
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --m_proxyCount;
+}
+
+bool DynamicAABBTree::MoveProxy(uint32_t proxy, const AABB& bounds, DirectX::XMFLOAT3 displacement)
+{
+    AABB fat = Grown(bounds, m_margin);
+    const float d[3] = { k_DisplacementScale * displacement.x,
+                         k_DisplacementScale * displacement.y,
+                         k_DisplacementScale * displacement.z };
+    float* lo[3] = { &fat.min.x, &fat.min.y, &fat.min.z };
+    float* hi[3] = { &fat.max.x, &fat.max.y, &fat.max.z };
+    for (int a = 0; a < 3; ++a)
+        *(d[a] < 0.0f ? lo[a] : hi[a]) += d[a];
+
+    // Keep the current box while it still encloses the proxy, unless it has
+    // become much bigger than needed (a proxy that stopped or turned).
+    const AABB& current = m_nodes[proxy].bounds;
+    if (Encloses(current, bounds) && Encloses(Grown(fat, 4.0f * m_margin), current))
+        return false;
+
+    RemoveLeaf(proxy);
+    m_nodes[proxy].bounds = fat;
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicAABBTree::Clear()
+{
+    m_nodes.clear();
+    m_root       = k_Null;
+    m_freeList   = k_Null;
+    m_proxyCount = 0;
+}
+
+uint32_t DynamicAABBTree::AllocateNode()
+{
+    if (m_freeList == k_Null)
+    {
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+    const uint32_t node = m_freeList;
+    m_freeList   = m_nodes[node].parent;
+    m_nodes[node] = Node{};
+    return node;
+}
+
+void DynamicAABBTree::FreeNode(uint32_t node)
+{
+    m_nodes[node]        = Node{};
+    m_nodes[node].parent = m_freeList;
+    m_freeList           = node;
+}
+
+void DynamicAABBTree::InsertLeaf(uint32_t leaf)
+{
+    if (m_root == k_Null)
+    {
+        m_root                = leaf;
+        m_nodes[leaf].parent  = k_Null;
+        return;
+    }
+
+    // Walk down towards the cheapest sibling: each step either stops here
+    // (new parent above index) or pays the growth of this node and descends.
+    const AABB leafBounds = m_nodes[leaf].bounds;
+    uint32_t index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const Node& n        = m_nodes[index];
+        const float area     = HalfArea(n.bounds);
+        const float combined = HalfArea(Union(n.bounds, leafBounds));
+        const float cost     = 2.0f * combined;
+        const float inherit  = 2.0f * (combined - area);
+
+        auto descendCost = [&](uint32_t child)
+        {
+            const Node& c = m_nodes[child];
+            const float grown = HalfArea(Union(leafBounds, c.bounds));
+            return (c.IsLeaf() ? grown : grown - HalfArea(c.bounds)) + inherit;
+        };
+        const float cost1 = descendCost(n.child1);
+        const float cost2 = descendCost(n.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? n.child1 : n.child2;
+    }
+
+    const uint32_t sibling   = index;
+    const uint32_t oldParent = m_nodes[sibling].parent;
+    const uint32_t newParent = AllocateNode(); // may grow m_nodes; no references held across
+    Node& p   = m_nodes[newParent];
+    p.parent  = oldParent;
+    p.bounds  = Union(leafBounds, m_nodes[sibling].bounds);
+    p.height  = m_nodes[sibling].height + 1;
+    p.child1  = sibling;
+    p.child2  = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent    = newParent;
+
+    if (oldParent == k_Null)
+        m_root = newParent;
+    else if (m_nodes[oldParent].child1 == sibling)
+        m_nodes[oldParent].child1 = newParent;
+    else
+        m_nodes[oldParent].child2 = newParent;
+
+    Refit(m_nodes[leaf].parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(uint32_t leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = k_Null;
+        return;
+    }
+
+    const uint32_t parent      = m_nodes[leaf].parent;
+    const uint32_t grandParent = m_nodes[parent].parent;
+    const uint32_t sibling     = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2
+                                                                : m_nodes[parent].child1;
+
+    // The sibling takes the parent's place.
+    m_nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+    if (grandParent == k_Null)
+    {
+        m_root = sibling;
+        return;
+    }
+    if (m_nodes[grandParent].child1 == parent)
+        m_nodes[grandParent].child1 = sibling;
+    else
+        m_nodes[grandParent].child2 = sibling;
+    Refit(grandParent);
+}
+
+void DynamicAABBTree::Refit(uint32_t node)
+{
+    while (node != k_Null)
+    {
+        node = Balance(node);
+        Node& n = m_nodes[node];
+        const Node& c1 = m_nodes[n.child1];
+        const Node& c2 = m_nodes[n.child2];
+        n.height = 1 + std::max(c1.height, c2.height);
+        n.bounds = Union(c1.bounds, c2.bounds);
+        node = n.parent;
+    }
+}
+
+// If a's subtrees differ in height by more than one, rotates the taller child
+// up into a's place. Returns the subtree's new root.
+uint32_t DynamicAABBTree::Balance(uint32_t a)
+{
+    Node& A = m_nodes[a];
+    if (A.IsLeaf() || A.height < 2) return a;
+
+    const uint32_t b = A.child1;
+    const uint32_t c = A.child2;
+    const int32_t balance = m_nodes[c].height - m_nodes[b].height;
+    if (balance >= -1 && balance <= 1) return a;
+
+    // up is the taller child, stay the other; up's taller child stays under up
+    // and its shorter one moves across to a.
+    const uint32_t up   = balance > 1 ? c : b;
+    const uint32_t stay = balance > 1 ? b : c;
+    Node& U = m_nodes[up];
+    const uint32_t f = U.child1;
+    const uint32_t g = U.child2;
+    const bool     fTaller = m_nodes[f].height > m_nodes[g].height;
+    const uint32_t keep    = fTaller ? f : g;
+    const uint32_t move    = fTaller ? g : f;
+
+    U.child1 = a;
+    U.parent = A.parent;
+    A.parent = up;
+    if (U.parent == k_Null)
+        m_root = up;
+    else if (m_nodes[U.parent].child1 == a)
+        m_nodes[U.parent].child1 = up;
+    else
+        m_nodes[U.parent].child2 = up;
+
+    U.child2 = keep;
+    if (up == c) A.child2 = move; else A.child1 = move;
+    m_nodes[move].parent = a;
+
+    const Node& S = m_nodes[stay];
+    const Node& M = m_nodes[move];
+    const Node& K = m_nodes[keep];
+    A.bounds = Union(S.bounds, M.bounds);
+    A.height = 1 + std::max(S.height, M.height);
+    U.bounds = Union(A.bounds, K.bounds);
+    U.height = 1 + std::max(A.height, K.height);
+    return up;
+}
+
+} // namespace SE
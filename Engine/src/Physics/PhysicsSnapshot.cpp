@@ -0,0 +1,273 @@
+#include "Engine/Physics/PhysicsWorld.h"
+#include <cstring>
+
+// PhysicsWorld::Snapshot / Restore. The format is a flat little-endian dump
+// meant for the same build on the same machine (replays, rollback), not for
+// storage: fields are written one by one with no padding, in the order below.
+//
+//   header   magic, version, counts, flags
+//   world    fixed-step clock and solver settings
+//   spheres  per body: position, previousPosition, velocity, force,
+//            mass, restitution, friction, radius, restSteps, flags
+//   planes   StaticPlane
+//   OBBs     StaticOBB
+//   meshes   triangle count (checked only)
+//   warm     CachedImpulse
+//   char     CharacterController motion state, if present
+
+namespace SE {
+
+using namespace DirectX;
+
+static constexpr uint32_t k_SnapshotMagic   = 0x53505846; // "FXPS"
+static constexpr uint32_t k_SnapshotVersion = 1;
+
+static constexpr size_t k_HeaderSize    = 4 * 7 + 1;
+static constexpr size_t k_WorldSize     = 4 + 8 + 4 + 4 + 4 + 4 + 1 + 1;
+static constexpr size_t k_SphereSize    = 12 * 4 + 4 * 4 + 4 + 1;
+static constexpr size_t k_PlaneSize     = sizeof(Plane) + 4 * 2;
+static constexpr size_t k_OBBSize       = sizeof(OBB) + 4 * 2;
+static constexpr size_t k_WarmSize      = 8 + 4 + 12;
+static constexpr size_t k_CharacterSize = 12 * 2 + 4 * 3 + 1;
+
+enum : uint8_t
+{
+    k_BodyEnabled  = 1 << 0,
+    k_BodyStatic   = 1 << 1,
+    k_BodyGravity  = 1 << 2,
+    k_BodyCanSleep = 1 << 3,
+    k_BodySleeping = 1 << 4,
+};
+
+namespace {
+
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    template<typename T>
+    void Put(const T& v)
+    {
+        size_t at = m_out.size();
+        m_out.resize(at + sizeof(T));
+        memcpy(m_out.data() + at, &v, sizeof(T));
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+// Unchecked: Restore validates the total size up front.
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(const uint8_t* data) : m_p(data) {}
+
+    template<typename T>
+    T Get()
+    {
+        T v;
+        memcpy(&v, m_p, sizeof(T));
+        m_p += sizeof(T);
+        return v;
+    }
+
+private:
+    const uint8_t* m_p;
+};
+
+} // namespace
+
+void PhysicsWorld::Snapshot(std::vector<uint8_t>& out, const CharacterController* cc) const
+{
+    out.clear();
+    SnapshotWriter w(out);
+
+    w.Put(k_SnapshotMagic);
+    w.Put(k_SnapshotVersion);
+    w.Put(static_cast<uint32_t>(m_spheres.size()));
+    w.Put(static_cast<uint32_t>(m_planes.size()));
+    w.Put(static_cast<uint32_t>(m_staticOBBs.size()));
+    w.Put(static_cast<uint32_t>(m_triMeshes.size()));
+    w.Put(static_cast<uint32_t>(m_warmStart.size()));
+    w.Put(static_cast<uint8_t>(cc ? 1 : 0));
+
+    w.Put(m_accumulator);
+    w.Put(m_tickCount);
+    w.Put(m_fixedTimeStep);
+    w.Put(m_maxSubsteps);
+    w.Put(m_velocityIterations);
+    w.Put(m_positionIterations);
+    w.Put(static_cast<uint8_t>(m_continuousCollision));
+    w.Put(static_cast<uint8_t>(m_sleepEnabled));
+
+    for (const SphereBody& s : m_spheres)
+    {
+        const RigidBodyComponent& rb = *s.body;
+        w.Put(s.transform->position);
+        w.Put(rb.previousPosition);
+        w.Put(rb.velocity);
+        w.Put(rb.force);
+        w.Put(rb.mass);
+        w.Put(rb.restitution);
+        w.Put(rb.friction);
+        w.Put(s.radius);
+        w.Put(rb.restSteps);
+        w.Put(static_cast<uint8_t>((rb.enabled    ? k_BodyEnabled  : 0) |
+                                   (rb.isStatic   ? k_BodyStatic   : 0) |
+                                   (rb.useGravity ? k_BodyGravity  : 0) |
+                                   (rb.canSleep   ? k_BodyCanSleep : 0) |
+                                   (rb.sleeping   ? k_BodySleeping : 0)));
+    }
+
+    for (const StaticPlane& p : m_planes)
+    {
+        w.Put(p.plane);
+        w.Put(p.restitution);
+        w.Put(p.friction);
+    }
+    for (const StaticOBB& o : m_staticOBBs)
+    {
+        w.Put(o.obb);
+        w.Put(o.restitution);
+        w.Put(o.friction);
+    }
+    for (const StaticTriangleMesh& m : m_triMeshes)
+        w.Put(m.mesh->GetTriangleCount());
+
+    for (const CachedImpulse& ci : m_warmStart)
+    {
+        w.Put(ci.key);
+        w.Put(ci.normalImpulse);
+        w.Put(ci.tangentImpulse);
+    }
+
+    if (cc)
+    {
+        w.Put(cc->position);
+        w.Put(cc->contactNormal);
+        w.Put(cc->velY);
+        w.Put(cc->physVelX);
+        w.Put(cc->physVelZ);
+        w.Put(static_cast<uint8_t>(cc->isGrounded));
+    }
+}
+
+bool PhysicsWorld::Restore(const std::vector<uint8_t>& data, CharacterController* cc)
+{
+    if (data.size() < k_HeaderSize) return false;
+
+    SnapshotReader r(data.data());
+    if (r.Get<uint32_t>() != k_SnapshotMagic)   return false;
+    if (r.Get<uint32_t>() != k_SnapshotVersion) return false;
+    const uint32_t sphereCount = r.Get<uint32_t>();
+    const uint32_t planeCount  = r.Get<uint32_t>();
+    const uint32_t obbCount    = r.Get<uint32_t>();
+    const uint32_t meshCount   = r.Get<uint32_t>();
+    const uint32_t warmCount   = r.Get<uint32_t>();
+    const bool     hasChar     = r.Get<uint8_t>() != 0;
+
+    const size_t expected = k_HeaderSize + k_WorldSize
+                          + size_t(sphereCount) * k_SphereSize
+                          + size_t(planeCount)  * k_PlaneSize
+                          + size_t(obbCount)    * k_OBBSize
+                          + size_t(meshCount)   * 4
+                          + size_t(warmCount)   * k_WarmSize
+                          + (hasChar ? k_CharacterSize : 0);
+    if (data.size() != expected) return false;
+    if (sphereCount != m_spheres.size() || meshCount != m_triMeshes.size()) return false;
+
+    // Meshes sit after the bodies and static shapes; check them before writing anything.
+    {
+        SnapshotReader m(data.data() + k_HeaderSize + k_WorldSize + size_t(sphereCount) * k_SphereSize
+                         + size_t(planeCount) * k_PlaneSize + size_t(obbCount) * k_OBBSize);
+        for (const StaticTriangleMesh& tm : m_triMeshes)
+            if (m.Get<uint32_t>() != tm.mesh->GetTriangleCount()) return false;
+    }
+
+    m_accumulator        = r.Get<float>();
+    m_tickCount          = r.Get<uint64_t>();
+    m_fixedTimeStep      = r.Get<float>();
+    m_maxSubsteps        = r.Get<uint32_t>();
+    m_velocityIterations = r.Get<uint32_t>();
+    m_positionIterations = r.Get<uint32_t>();
+    m_continuousCollision = r.Get<uint8_t>() != 0;
+    m_sleepEnabled        = r.Get<uint8_t>() != 0;
+
+    for (SphereBody& s : m_spheres)
+    {
+        RigidBodyComponent& rb = *s.body;
+        s.transform->position = r.Get<XMFLOAT3>();
+        rb.previousPosition   = r.Get<XMFLOAT3>();
+        rb.velocity           = r.Get<XMFLOAT3>();
+        rb.force              = r.Get<XMFLOAT3>();
+        rb.mass               = r.Get<float>();
+        rb.restitution        = r.Get<float>();
+        rb.friction           = r.Get<float>();
+        s.radius              = r.Get<float>();
+        rb.restSteps          = r.Get<uint32_t>();
+        const uint8_t flags   = r.Get<uint8_t>();
+        rb.enabled    = (flags & k_BodyEnabled)  != 0;
+        rb.isStatic   = (flags & k_BodyStatic)   != 0;
+        rb.useGravity = (flags & k_BodyGravity)  != 0;
+        rb.canSleep   = (flags & k_BodyCanSleep) != 0;
+        rb.sleeping   = (flags & k_BodySleeping) != 0;
+    }
+
+    m_planes.resize(planeCount);
+    for (StaticPlane& p : m_planes)
+    {
+        p.plane       = r.Get<Plane>();
+        p.restitution = r.Get<float>();
+        p.friction    = r.Get<float>();
+    }
+
+    // Static OBBs usually haven't moved since the snapshot; only touch the
+    // hash and BVH for the ones that did, so a rollback stays cheap. A
+    // different count rebuilds both below, before any query can index the
+    // old tree into the resized array.
+    const bool obbsResized = obbCount != m_staticOBBs.size();
+    if (obbsResized)
+        m_staticOBBs.resize(obbCount);
+    for (uint32_t i = 0; i < obbCount; ++i)
+    {
+        StaticOBB& o  = m_staticOBBs[i];
+        const OBB obb = r.Get<OBB>();
+        o.restitution = r.Get<float>();
+        o.friction    = r.Get<float>();
+        if (memcmp(&obb, &o.obb, sizeof(OBB)) == 0) continue;
+        o.obb         = obb;
+        m_staticDirty = true;
+        if (i < m_bvhPrimCount) m_bvhNeedsRefit = true;
+    }
+    if (obbsResized)
+    {
+        RebuildStaticHash();
+        RebuildStaticBVH();
+    }
+
+    for (uint32_t i = 0; i < meshCount; ++i)
+        r.Get<uint32_t>(); // triangle counts, checked above
+
+    m_warmStart.resize(warmCount);
+    for (CachedImpulse& ci : m_warmStart)
+    {
+        ci.key            = r.Get<uint64_t>();
+        ci.normalImpulse  = r.Get<float>();
+        ci.tangentImpulse = r.Get<XMFLOAT3>();
+    }
+
+    if (hasChar && cc)
+    {
+        cc->position      = r.Get<XMFLOAT3>();
+        cc->contactNormal = r.Get<XMFLOAT3>();
+        cc->velY          = r.Get<float>();
+        cc->physVelX      = r.Get<float>();
+        cc->physVelZ      = r.Get<float>();
+        cc->isGrounded    = r.Get<uint8_t>() != 0;
+    }
+    return true;
+}
+
+} // namespace SE
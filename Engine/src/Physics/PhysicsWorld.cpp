@@ -1,6 +1,11 @@
 #include "Engine/Physics/PhysicsWorld.h"
 #include "Engine/Physics/Intersect.h"
+#include "Engine/Physics/RayPacket.h"
+#include <atomic>
+#include <cassert>
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <cfloat>
 
 namespace SE {
@@ -17,10 +22,6 @@ static XMFLOAT3 Scale(const XMFLOAT3& v, float s)
 {
     return { v.x*s, v.y*s, v.z*s };
 }
-static XMFLOAT3 Add(const XMFLOAT3& a, const XMFLOAT3& b)
-{
-    return { a.x+b.x, a.y+b.y, a.z+b.z };
-}
 static XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b)
 {
     return { a.x-b.x, a.y-b.y, a.z-b.z };
@@ -29,12 +30,111 @@ static float Len(const XMFLOAT3& v)
 {
     return sqrtf(v.x*v.x + v.y*v.y + v.z*v.z);
 }
+// Warm-start identity: body a in the high word, the other side in the low word
+// as a 4-bit kind over a 28-bit index. Aliasing (a > 13th mesh, > 268M
+// triangles) only costs warm-start quality, never correctness.
+enum : uint32_t { k_FeatureSphere = 0, k_FeaturePlane = 1, k_FeatureOBB = 2, k_FeatureMesh = 3 };
+
+static uint64_t ContactKey(uint32_t a, uint32_t kind, uint32_t index)
+{
+    return (static_cast<uint64_t>(a) << 32) | ((kind & 0xFu) << 28) | (index & 0x0FFFFFFFu);
+}
+
+// Solver tuning.
+static constexpr float k_LinearSlop           = 0.002f; // allowed penetration, stops jitter at rest
+static constexpr float k_Speculative          = 0.05f;  // contacts start this far before touching
+static constexpr float k_PositionBeta         = 0.8f;   // fraction of penetration removed per pass
+static constexpr float k_RestitutionThreshold = 0.5f;   // m/s; slower impacts don't bounce
+static constexpr float k_CcdMotionFraction    = 0.5f;   // sweep bodies moving further than this * radius per step
+static constexpr int   k_MaxCcdSweeps         = 4;      // times of impact resolved per fast body per step
+
+// Sleeping.
+static constexpr float    k_SleepSpeed = 0.05f; // m/s; slower than this counts as resting
+static constexpr uint32_t k_SleepSteps = 30;    // resting steps before a body may sleep
+
+static constexpr uint32_t k_RaysPerTask = 64; // RaycastBatch work unit when running as jobs
 
 // ---- public ----------------------------------------------------------------
 
+PhysicsWorld::PhysicsWorld()
+    : m_broadphase(std::make_unique<SweepAndPruneBroadphase>())
+{
+}
+
+void PhysicsWorld::SetBroadphase(std::unique_ptr<Broadphase> broadphase)
+{
+    m_broadphase = std::move(broadphase);
+    if (m_broadphase) m_broadphase->SetJobSystem(m_jobs);
+}
+
+void PhysicsWorld::SetJobSystem(JobSystem* jobs)
+{
+    m_jobs = jobs;
+    if (m_broadphase) m_broadphase->SetJobSystem(m_jobs);
+}
+
+void PhysicsWorld::SetSolverIterations(uint32_t velocityIterations, uint32_t positionIterations)
+{
+    m_velocityIterations = velocityIterations;
+    m_positionIterations = positionIterations;
+}
+
+void PhysicsWorld::SetStaticCellSize(float cellSize)
+{
+    m_staticHash.SetCellSize(cellSize);
+    m_staticDirty = true;
+}
+
+void PhysicsWorld::SetFixedTimeStep(float seconds, uint32_t maxSubsteps)
+{
+    // Zero, negative or NaN would stall Simulate's loop and divide by zero in
+    // GetInterpolationAlpha; keep the current step instead.
+    assert(seconds > 0.0f && "fixed time step must be positive");
+    if (!(seconds > 0.0f)) return;
+
+    m_fixedTimeStep = seconds;
+    m_maxSubsteps   = maxSubsteps > 0 ? maxSubsteps : 1;
+    m_accumulator   = 0.0f;
+}
+
+uint32_t PhysicsWorld::Simulate(float frameDt)
+{
+    m_accumulator += frameDt;
+
+    uint32_t steps = 0;
+    while (m_accumulator >= m_fixedTimeStep && steps < m_maxSubsteps)
+    {
+        Tick();
+        m_accumulator -= m_fixedTimeStep;
+        ++steps;
+    }
+
+    // Over budget: keep only the partial step so alpha stays in [0, 1).
+    if (m_accumulator >= m_fixedTimeStep)
+        m_accumulator = fmodf(m_accumulator, m_fixedTimeStep);
+    return steps;
+}
+
+void PhysicsWorld::Resimulate(uint32_t ticks)
+{
+    for (uint32_t i = 0; i < ticks; ++i)
+        Tick();
+}
+
+XMFLOAT3 PhysicsWorld::GetInterpolatedPosition(const TransformComponent& t, const RigidBodyComponent& rb) const
+{
+    XMFLOAT3 p;
+    XMStoreFloat3(&p, XMVectorLerp(XMLoadFloat3(&rb.previousPosition), XMLoadFloat3(&t.position),
+                                   GetInterpolationAlpha()));
+    return p;
+}
+
 void PhysicsWorld::AddSphere(TransformComponent* t, RigidBodyComponent* rb, float radius)
 {
     m_spheres.push_back({ t, rb, radius });
+    rb->simulatedByWorld = true;
+    rb->previousPosition = t->position;
+    rb->WakeUp();
 }
 
 void PhysicsWorld::AddStaticPlane(Plane plane, float restitution, float friction)
@@ -45,6 +145,14 @@ void PhysicsWorld::AddStaticPlane(Plane plane, float restitution, float friction
 void PhysicsWorld::AddStaticOBB(OBB obb, float restitution, float friction)
 {
     m_staticOBBs.push_back({ obb, restitution, friction });
+    m_staticDirty = true;
+}
+
+void PhysicsWorld::AddStaticTriangleMesh(std::shared_ptr<const TriangleMesh> mesh,
+                                         float restitution, float friction)
+{
+    if (!mesh || mesh->GetTriangleCount() == 0) return;
+    m_triMeshes.push_back({ std::move(mesh), restitution, friction });
 }
 
 void PhysicsWorld::Clear()
@@ -52,6 +160,44 @@ void PhysicsWorld::Clear()
     m_spheres.clear();
     m_planes.clear();
     m_staticOBBs.clear();
+    m_triMeshes.clear();
+    m_staticHash.Clear();
+    m_staticDirty = true;
+    m_staticBVH.Clear();
+    m_staticBounds.clear();
+    m_bvhPrimCount  = 0;
+    m_bvhNeedsRefit = false;
+    m_contacts.clear();
+    m_warmStart.clear();
+    m_accumulator = 0.0f;
+    m_tickCount   = 0;
+    if (m_broadphase) m_broadphase->Clear();
+}
+
+void PhysicsWorld::SetStaticOBB(uint32_t index, const OBB& obb)
+{
+    m_staticOBBs[index].obb = obb;
+    m_staticDirty = true;
+    if (index < m_bvhPrimCount) m_bvhNeedsRefit = true;
+}
+
+void PhysicsWorld::RebuildStaticBVH()
+{
+    m_staticBounds.resize(m_staticOBBs.size());
+    for (size_t i = 0; i < m_staticOBBs.size(); ++i)
+        m_staticBounds[i] = m_staticOBBs[i].obb.GetAABB();
+
+    m_bvhPrimCount = static_cast<uint32_t>(m_staticOBBs.size());
+    m_staticBVH.Build(m_staticBounds.data(), m_bvhPrimCount);
+    m_bvhNeedsRefit = false;
+}
+
+void PhysicsWorld::RefitStaticBVH()
+{
+    for (uint32_t i = 0; i < m_bvhPrimCount; ++i)
+        m_staticBounds[i] = m_staticOBBs[i].obb.GetAABB();
+    m_staticBVH.Refit(m_staticBounds.data());
+    m_bvhNeedsRefit = false;
 }
 
 bool PhysicsWorld::Raycast(const Ray& ray, RaycastHit& hit) const
@@ -91,11 +237,11 @@ bool PhysicsWorld::Raycast(const Ray& ray, RaycastHit& hit) const
         hit.kind      = RaycastHit::Kind::Plane;
     }
 
-    for (const auto& so : m_staticOBBs)
+    auto testOBB = [&](uint32_t i, float tMax) -> float
     {
         float     t  = 0.0f;
         XMFLOAT3  n  = {};
-        if (!Intersects(ray, so.obb, t, n) || t >= best) continue;
+        if (!Intersects(ray, m_staticOBBs[i].obb, t, n) || t >= tMax) return tMax;
 
         best          = t;
         found         = true;
@@ -104,6 +250,238 @@ bool PhysicsWorld::Raycast(const Ray& ray, RaycastHit& hit) const
         hit.normal    = n;
         hit.transform = nullptr;
         hit.kind      = RaycastHit::Kind::OBB;
+        return t;
+    };
+
+    // Stale tree bounds can't be trusted for culling — fall back to a full scan.
+    uint32_t linearFrom = m_bvhNeedsRefit ? 0u : m_bvhPrimCount;
+    if (!m_bvhNeedsRefit)
+        m_staticBVH.QueryRay(ray, best, testOBB);
+    for (uint32_t i = linearFrom; i < static_cast<uint32_t>(m_staticOBBs.size()); ++i)
+        best = testOBB(i, best);
+
+    for (const auto& tm : m_triMeshes)
+    {
+        float    t = 0.0f;
+        XMFLOAT3 n = {};
+        if (!tm.mesh->Raycast(ray, best, t, n)) continue;
+
+        best          = t;
+        found         = true;
+        hit.t         = t;
+        hit.point     = ray.PointAt(t);
+        hit.normal    = n;
+        hit.transform = nullptr;
+        hit.kind      = RaycastHit::Kind::TriangleMesh;
+    }
+
+    return found;
+}
+
+uint32_t PhysicsWorld::RaycastBatch(const Ray* rays, uint32_t count, RaycastHit* hits, bool parallel) const
+{
+    const uint32_t width = RayPacket4::k_Width;
+
+    if (!parallel || GetThreadCount() <= 1 || count <= k_RaysPerTask)
+    {
+        uint32_t found = 0;
+        for (uint32_t i = 0; i < count; i += width)
+            found += RaycastPacket(rays + i, count - i < width ? count - i : width, hits + i);
+        return found;
+    }
+
+    std::atomic<uint32_t> found{ 0 };
+    const uint32_t tasks = (count + k_RaysPerTask - 1) / k_RaysPerTask;
+    auto runTask = [&](uint32_t task)
+    {
+        uint32_t first = task * k_RaysPerTask;
+        uint32_t last  = first + k_RaysPerTask < count ? first + k_RaysPerTask : count;
+        uint32_t local = 0;
+        for (uint32_t i = first; i < last; i += width)
+            local += RaycastPacket(rays + i, last - i < width ? last - i : width, hits + i);
+        found.fetch_add(local, std::memory_order_relaxed);
+    };
+    m_jobs->ParallelFor(tasks, 1, runTask);
+    return found.load(std::memory_order_relaxed);
+}
+
+// Mirrors Raycast shape by shape, including its tie-breaking (a later shape only
+// wins when strictly closer), so both report the same hit. The packet pass keeps
+// only t, kind and shape index per lane; points and normals are filled per ray.
+uint32_t PhysicsWorld::RaycastPacket(const Ray* rays, uint32_t count, RaycastHit* hits) const
+{
+    const RayPacket4 packet = RayPacket4::Load(rays, count);
+
+    XMVECTOR best  = XMVectorReplicate(FLT_MAX);
+    XMVECTOR kind  = XMVectorZero(); // RaycastHit::Kind per lane, as integer bits
+    XMVECTOR index = XMVectorZero(); // shape index per lane
+
+    auto take = [&](FXMVECTOR mask, FXMVECTOR t, RaycastHit::Kind k, uint32_t i)
+    {
+        XMVECTOR closer = XMVectorAndInt(mask, XMVectorLess(t, best));
+        best  = XMVectorSelect(best,  t, closer);
+        kind  = XMVectorSelect(kind,  XMVectorReplicateInt(static_cast<uint32_t>(k)), closer);
+        index = XMVectorSelect(index, XMVectorReplicateInt(i), closer);
+    };
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_spheres.size()); ++i)
+    {
+        Sphere   s = { m_spheres[i].transform->position, m_spheres[i].radius };
+        XMVECTOR t;
+        XMVECTOR mask = Intersects(packet, s, t);
+        take(mask, t, RaycastHit::Kind::Sphere, i);
+    }
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_planes.size()); ++i)
+    {
+        XMVECTOR t;
+        XMVECTOR mask = Intersects(packet, m_planes[i].plane, t);
+        take(mask, t, RaycastHit::Kind::Plane, i);
+    }
+
+    auto testOBB = [&](uint32_t i, FXMVECTOR) -> XMVECTOR
+    {
+        XMVECTOR t;
+        XMVECTOR mask = Intersects(packet, m_staticOBBs[i].obb, t);
+        take(mask, t, RaycastHit::Kind::OBB, i);
+        return best;
+    };
+
+    uint32_t linearFrom = m_bvhNeedsRefit ? 0u : m_bvhPrimCount;
+    if (!m_bvhNeedsRefit)
+        m_staticBVH.QueryRayPacket(packet, best, testOBB);
+    for (uint32_t i = linearFrom; i < static_cast<uint32_t>(m_staticOBBs.size()); ++i)
+        testOBB(i, best);
+
+    XMFLOAT4A bestT;
+    uint32_t  kinds[4], indices[4];
+    XMStoreFloat4A(&bestT, best);
+    XMStoreInt4(kinds, kind);
+    XMStoreInt4(indices, index);
+
+    uint32_t found = 0;
+    for (uint32_t l = 0; l < count; ++l)
+    {
+        const Ray&  ray = rays[l];
+        RaycastHit& hit = hits[l];
+        float       t   = (&bestT.x)[l];
+        auto        k   = static_cast<RaycastHit::Kind>(kinds[l]);
+        uint32_t    i   = indices[l];
+
+        hit = RaycastHit{};
+        for (const auto& tm : m_triMeshes)
+        {
+            float    tt = 0.0f;
+            XMFLOAT3 n  = {};
+            if (!tm.mesh->Raycast(ray, t, tt, n)) continue;
+            t          = tt;
+            k          = RaycastHit::Kind::TriangleMesh;
+            hit.normal = n;
+        }
+
+        if (t == FLT_MAX)
+        {
+            hit.t = FLT_MAX;
+            continue;
+        }
+
+        ++found;
+        hit.t     = t;
+        hit.point = ray.PointAt(t);
+        hit.kind  = k;
+        switch (k)
+        {
+        case RaycastHit::Kind::Sphere:
+            hit.transform = m_spheres[i].transform;
+            XMStoreFloat3(&hit.normal, XMVector3Normalize(
+                XMVectorSubtract(XMLoadFloat3(&hit.point), XMLoadFloat3(&hit.transform->position))));
+            break;
+        case RaycastHit::Kind::Plane:
+            hit.normal = m_planes[i].plane.normal;
+            break;
+        case RaycastHit::Kind::OBB:
+        {
+            float tt = 0.0f;
+            Intersects(ray, m_staticOBBs[i].obb, tt, hit.normal);
+            break;
+        }
+        case RaycastHit::Kind::TriangleMesh:
+            break;
+        }
+    }
+    return found;
+}
+
+bool PhysicsWorld::SphereCast(const Ray& ray, float radius, float maxDist, RaycastHit& hit) const
+{
+    SweepHit sweep = {};
+    sweep.t        = maxDist;
+    bool found     = SweepStatic(ray, radius, sweep);
+
+    TransformComponent* transform = nullptr;
+    for (const auto& sb : m_spheres)
+    {
+        Sphere   s = { sb.transform->position, sb.radius };
+        float    t = 0.0f;
+        XMFLOAT3 n = {};
+        if (!SE::SphereCast(ray, radius, s, t, n) || t >= sweep.t) continue;
+
+        found        = true;
+        sweep.t      = t;
+        sweep.normal = n;
+        sweep.kind   = RaycastHit::Kind::Sphere;
+        transform    = sb.transform;
+    }
+    if (!found) return false;
+
+    XMFLOAT3 center = ray.PointAt(sweep.t);
+    hit.t         = sweep.t;
+    hit.point     = Sub(center, Scale(sweep.normal, radius));
+    hit.normal    = sweep.normal;
+    hit.transform = transform;
+    hit.kind      = sweep.kind;
+    return true;
+}
+
+bool PhysicsWorld::ClosestStaticPoint(XMFLOAT3 p, float maxDist, XMFLOAT3& closest) const
+{
+    float bestSq = maxDist * maxDist;
+    bool  found  = false;
+
+    for (const auto& sp : m_planes)
+    {
+        float d = sp.plane.SignedDistance(p);
+        if (d * d > bestSq) continue;
+        bestSq  = d * d;
+        closest = Sub(p, Scale(sp.plane.normal, d));
+        found   = true;
+    }
+
+    auto testOBB = [&](uint32_t i, float maxSq) -> float
+    {
+        XMFLOAT3 c     = ClosestPoint(m_staticOBBs[i].obb, p);
+        XMFLOAT3 delta = Sub(p, c);
+        float    dSq   = Dot(delta, delta);
+        if (dSq > maxSq) return maxSq;
+        closest = c;
+        found   = true;
+        return dSq;
+    };
+
+    uint32_t linearFrom = m_bvhNeedsRefit ? 0u : m_bvhPrimCount;
+    if (!m_bvhNeedsRefit)
+        m_staticBVH.QueryClosest(p, bestSq, [&](uint32_t i, float maxSq) { return bestSq = testOBB(i, maxSq); });
+    for (uint32_t i = linearFrom; i < static_cast<uint32_t>(m_staticOBBs.size()); ++i)
+        bestSq = testOBB(i, bestSq);
+
+    for (const auto& tm : m_triMeshes)
+    {
+        XMFLOAT3 c;
+        if (!tm.mesh->ClosestPoint(p, sqrtf(bestSq), c)) continue;
+        XMFLOAT3 delta = Sub(p, c);
+        bestSq  = Dot(delta, delta);
+        closest = c;
+        found   = true;
     }
 
     return found;
@@ -142,6 +520,66 @@ void PhysicsWorld::StepCharacter(CharacterController& cc, XMFLOAT3 wishVel, floa
         return { cc.position.x, cc.position.y + cc.radius, cc.position.z };
     };
 
+    // Candidate static OBBs and triangles for this frame's whole move, gathered once.
+    UpdateStaticBVH();
+    {
+        float    reach = cc.radius * 2.0f + skin
+                       + fabsf(cc.velY * dt) + (fabsf(wishVel.x) + fabsf(wishVel.z)
+                       + fabsf(cc.physVelX) + fabsf(cc.physVelZ)) * dt + cc.stepHeight;
+        AABB     box   = AABB::FromCenterExtents(bottomCenter(), { reach, reach, reach });
+        m_candidates.clear();
+        GatherStaticOBBs(box, m_candidates);
+        m_triCandidates.clear();
+        for (const auto& tm : m_triMeshes)
+            if (tm.mesh->GetBounds().Overlaps(box))
+                tm.mesh->QueryAABB(box, [&](const TriangleMesh::Triangle& tri) { m_triCandidates.push_back(&tri); });
+    }
+
+    // Surface contact against a closest point (OBB or triangle).
+    auto verticalContact = [&](const XMFLOAT3& closest) {
+        XMFLOAT3 c     = bottomCenter();
+        XMFLOAT3 delta = Sub(c, closest);
+        float    dist  = Len(delta);
+        if (dist >= cc.radius + skin || dist < 1e-6f) return;
+        XMFLOAT3 n = Scale(delta, 1.0f / dist);
+        addContact(n);
+        if (n.y > cosSlope && cc.velY < 0.0f) cc.velY = 0.0f;
+        if (dist < cc.radius) {
+            float pen = cc.radius - dist;
+            cc.position.x += n.x * pen;
+            cc.position.y += n.y * pen;
+            cc.position.z += n.z * pen;
+        }
+    };
+
+    // Walls: step up onto anything whose top is within stepHeight, else slide.
+    auto horizontalContact = [&](const XMFLOAT3& closest, float topY) {
+        XMFLOAT3 c     = bottomCenter();
+        XMFLOAT3 delta = Sub(c, closest);
+        float    dist  = Len(delta);
+        if (dist >= cc.radius + skin || dist < 1e-6f) return;
+        XMFLOAT3 n = Scale(delta, 1.0f / dist);
+        if (n.y > cosSlope) return; // floor — handled in vertical pass
+
+        if (topY > cc.position.y && topY <= cc.position.y + cc.stepHeight)
+        {
+            if (dist < cc.radius) {
+                cc.position.y = topY;
+                if (cc.velY < 0.0f) cc.velY = 0.0f;
+            }
+            addContact({ 0.0f, 1.0f, 0.0f });
+        }
+        else
+        {
+            if (dist < cc.radius) {
+                float pen = cc.radius - dist;
+                cc.position.x += n.x * pen;
+                cc.position.z += n.z * pen;
+            }
+            addContact(n);
+        }
+    };
+
     const float safeStep = cc.radius * 0.8f;
     int   substeps = static_cast<int>(ceilf(fabsf(cc.velY * dt) / safeStep));
     if (substeps < 1) substeps = 1;
@@ -168,33 +606,10 @@ void PhysicsWorld::StepCharacter(CharacterController& cc, XMFLOAT3 wishVel, floa
             }
         }
 
-        for (const auto& so : m_staticOBBs)
-        {
-            XMFLOAT3 c = bottomCenter();
-            XMFLOAT3 d = Sub(c, so.obb.center);
-            XMFLOAT3 closest = so.obb.center;
-            for (int i = 0; i < 3; ++i)
-            {
-                float proj = Dot(d, so.obb.axes[i]);
-                float he   = (&so.obb.halfExtents.x)[i];
-                float p    = proj < -he ? -he : (proj > he ? he : proj);
-                closest.x += p * so.obb.axes[i].x;
-                closest.y += p * so.obb.axes[i].y;
-                closest.z += p * so.obb.axes[i].z;
-            }
-            XMFLOAT3 delta = Sub(c, closest);
-            float     dist  = Len(delta);
-            if (dist >= cc.radius + skin || dist < 1e-6f) continue;
-            XMFLOAT3 n = Scale(delta, 1.0f / dist);
-            addContact(n);
-            if (n.y > cosSlope && cc.velY < 0.0f) cc.velY = 0.0f;
-            if (dist < cc.radius) {
-                float pen = cc.radius - dist;
-                cc.position.x += n.x * pen;
-                cc.position.y += n.y * pen;
-                cc.position.z += n.z * pen;
-            }
-        }
+        for (uint32_t oi : m_candidates)
+            verticalContact(ClosestPoint(m_staticOBBs[oi].obb, bottomCenter()));
+        for (const auto* tri : m_triCandidates)
+            verticalContact(TriangleMesh::ClosestPointOnTriangle(bottomCenter(), *tri));
 
         if (cc.velY == 0.0f) break; // grounded mid-step, no need to continue
     }
@@ -219,174 +634,808 @@ void PhysicsWorld::StepCharacter(CharacterController& cc, XMFLOAT3 wishVel, floa
         }
     }
 
-    for (const auto& so : m_staticOBBs)
+    for (uint32_t oi : m_candidates)
     {
-        XMFLOAT3 c = bottomCenter();
-        XMFLOAT3 d = Sub(c, so.obb.center);
-        XMFLOAT3 closest = so.obb.center;
-        for (int i = 0; i < 3; ++i)
+        const OBB& obb = m_staticOBBs[oi].obb;
+        float obbMaxY = obb.center.y
+            + fabsf(obb.axes[0].y) * obb.halfExtents.x
+            + fabsf(obb.axes[1].y) * obb.halfExtents.y
+            + fabsf(obb.axes[2].y) * obb.halfExtents.z;
+        horizontalContact(ClosestPoint(obb, bottomCenter()), obbMaxY);
+    }
+    for (const auto* tri : m_triCandidates)
+        horizontalContact(TriangleMesh::ClosestPointOnTriangle(bottomCenter(), *tri), tri->MaxY());
+
+    // ---- Finalize contact normal ----
+    float len = Len(accNormal);
+    if (len > 1e-6f)
+        cc.contactNormal = Scale(accNormal, 1.0f / len);
+}
+
+void PhysicsWorld::Step(float dt)
+{
+    m_stats        = {};
+    m_stats.bodies = static_cast<uint32_t>(m_spheres.size());
+
+    if (m_staticDirty) RebuildStaticHash();
+    UpdateStaticBVH();
+
+    GatherBodies();
+    IntegrateVelocities(dt);
+    UpdateSphereBounds(k_Speculative);
+    m_contacts.clear();
+
+    // Grow fast bodies' bounds along their (pre-solve) motion, so the pairs
+    // below also hold every sphere SweepFastBodies may run into.
+    if (m_continuousCollision)
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_spheres.size()); ++i)
         {
-            float proj = Dot(d, so.obb.axes[i]);
-            float he   = (&so.obb.halfExtents.x)[i];
-            float p    = proj < -he ? -he : (proj > he ? he : proj);
-            closest.x += p * so.obb.axes[i].x;
-            closest.y += p * so.obb.axes[i].y;
-            closest.z += p * so.obb.axes[i].z;
+            if (!m_bodies.dynamic[i]) continue;
+            const XMFLOAT4A& v     = m_bodies.velocity[i];
+            float            reach = k_CcdMotionFraction * m_bodies.position[i].w;
+            XMFLOAT3         d     = { v.x * dt, v.y * dt, v.z * dt };
+            if (Dot(d, d) <= reach * reach) continue;
+            AABB& b = m_sphereBounds[i];
+            b.Expand({ b.min.x + d.x, b.min.y + d.y, b.min.z + d.z });
+            b.Expand({ b.max.x + d.x, b.max.y + d.y, b.max.z + d.z });
         }
-        XMFLOAT3 delta = Sub(c, closest);
-        float     dist  = Len(delta);
-        if (dist >= cc.radius + skin || dist < 1e-6f) continue;
-        XMFLOAT3 n = Scale(delta, 1.0f / dist);
-        if (n.y > cosSlope) continue; // floor — handled in vertical pass
+    }
+
+    // Broadphase from the awake bodies only; two sleepers are never paired.
+    m_pairs.clear();
+    m_broadphase->Update(m_sphereBounds.data(), static_cast<uint32_t>(m_sphereBounds.size()));
+    m_broadphase->FindActivePairs(m_bodies.dynamic.data(), m_pairs);
+    m_stats.spherePairs = static_cast<uint32_t>(m_pairs.size());
+    if (m_sleepEnabled) WakeTouchedBodies(dt);
+
+    // Static contacts.
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_spheres.size()); ++i)
+    {
+        if (!m_bodies.dynamic[i]) continue;
+
+        for (uint32_t p = 0; p < static_cast<uint32_t>(m_planes.size()); ++p)
+            CollideSphereVsPlane(i, p);
+        m_stats.staticPairs += static_cast<uint32_t>(m_planes.size());
 
-        float obbMaxY = so.obb.center.y
-            + fabsf(so.obb.axes[0].y) * so.obb.halfExtents.x
-            + fabsf(so.obb.axes[1].y) * so.obb.halfExtents.y
-            + fabsf(so.obb.axes[2].y) * so.obb.halfExtents.z;
+        const XMFLOAT4A& pos = m_bodies.position[i];
+        const XMFLOAT3   c   = { pos.x, pos.y, pos.z };
+        const float      r   = pos.w + k_Speculative;
+        const AABB       box = AABB::FromCenterExtents(c, { r, r, r }); // unswept, unlike m_sphereBounds
 
-        if (obbMaxY > cc.position.y && obbMaxY <= cc.position.y + cc.stepHeight)
+        m_candidates.clear();
+        m_staticHash.Query(box, m_candidates);
+        for (uint32_t o : m_candidates)
         {
-            if (dist < cc.radius) {
-                cc.position.y = obbMaxY;
-                if (cc.velY < 0.0f) cc.velY = 0.0f;
-            }
-            addContact({ 0.0f, 1.0f, 0.0f });
+            const StaticOBB& so = m_staticOBBs[o];
+            CollideSphereVsPoint(i, ClosestPoint(so.obb, c), ContactKey(i, k_FeatureOBB, o),
+                                 so.restitution, so.friction);
         }
-        else
+        m_stats.staticPairs += static_cast<uint32_t>(m_candidates.size());
+
+        for (uint32_t m = 0; m < static_cast<uint32_t>(m_triMeshes.size()); ++m)
         {
-            if (dist < cc.radius) {
-                float pen = cc.radius - dist;
-                cc.position.x += n.x * pen;
-                cc.position.z += n.z * pen;
+            const StaticTriangleMesh& tm = m_triMeshes[m];
+            if (!tm.mesh->GetBounds().Overlaps(box)) continue;
+            const TriangleMesh::Triangle* first = tm.mesh->GetTriangles().data();
+            tm.mesh->QueryAABB(box, [&](const TriangleMesh::Triangle& tri)
+            {
+                uint32_t t = static_cast<uint32_t>(&tri - first);
+                CollideSphereVsPoint(i, TriangleMesh::ClosestPointOnTriangle(c, tri),
+                                     ContactKey(i, k_FeatureMesh + m, t), tm.restitution, tm.friction);
+                ++m_stats.staticPairs;
+            });
+        }
+    }
+
+    // Dynamic contacts — narrowphase only on broadphase candidates.
+    for (const auto& pr : m_pairs)
+        CollideSphereVsSphere(pr.a, pr.b);
+
+    ApplyWarmStart();
+    BuildIslands();
+
+    auto forEachIsland = [this](const std::function<void(const Island&)>& fn) {
+        const uint32_t count = static_cast<uint32_t>(m_islandOrder.size());
+        auto solve = [&](uint32_t k) { fn(m_islands[m_islandOrder[k]]); };
+        ParallelFor(m_jobs, count, 1, solve);
+    };
+
+    // Speculative contacts assume positions move with the solved velocities,
+    // so positions are integrated between the two solver phases.
+    forEachIsland([&](const Island& island) { SolveIslandVelocities(island, dt); });
+    IntegratePositions(dt);
+    SweepFastBodies(dt);
+    forEachIsland([&](const Island& island) { SolveIslandPositions(island); });
+    StoreWarmStart();
+    if (m_sleepEnabled) UpdateSleep();
+
+    m_stats.contacts = static_cast<uint32_t>(m_contacts.size());
+    m_stats.islands  = static_cast<uint32_t>(m_islands.size());
+    m_stats.ccdBodies = static_cast<uint32_t>(m_fastBodies.size());
+
+    ScatterBodies();
+}
+
+// ---- private ---------------------------------------------------------------
+
+void PhysicsWorld::Tick()
+{
+    for (const SphereBody& s : m_spheres)
+        s.body->previousPosition = s.transform->position;
+    Step(m_fixedTimeStep);
+    ++m_tickCount;
+}
+
+void PhysicsWorld::BodyArrays::Resize(size_t count)
+{
+    position.resize(count);
+    velocity.resize(count);
+    accel.resize(count);
+    invMass.resize(count);
+    restitution.resize(count);
+    friction.resize(count);
+    dynamic.resize(count);
+}
+
+// The only pass that touches the components before the write-back. Forces are
+// consumed here (they were cleared by RigidBodyComponent::Update before).
+void PhysicsWorld::GatherBodies()
+{
+    m_bodies.Resize(m_spheres.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_spheres.size()); ++i)
+    {
+        RigidBodyComponent& rb = *m_spheres[i].body;
+        if (rb.sleeping)
+        {
+            if (m_sleepEnabled) ++m_stats.sleeping;
+            else                rb.WakeUp();
+        }
+        GatherBody(i);
+    }
+}
+
+void PhysicsWorld::GatherBody(uint32_t i)
+{
+    const SphereBody&   sb = m_spheres[i];
+    RigidBodyComponent& rb = *sb.body;
+    const XMFLOAT3&     p  = sb.transform->position;
+
+    // Disabled and sleeping bodies are immovable, so islands never share a writable body.
+    bool  dynamic = !rb.isStatic && rb.enabled && !rb.sleeping;
+    float invMass = (dynamic && rb.mass > 0.0f) ? 1.0f / rb.mass : 0.0f;
+    float gravity = (dynamic && rb.useGravity) ? RigidBodyComponent::kGravity : 0.0f;
+
+    m_bodies.position[i]    = { p.x, p.y, p.z, sb.radius };
+    m_bodies.velocity[i]    = { rb.velocity.x, rb.velocity.y, rb.velocity.z, 0.0f };
+    m_bodies.accel[i]       = { rb.force.x * invMass, rb.force.y * invMass + gravity,
+                                rb.force.z * invMass, 0.0f };
+    m_bodies.invMass[i]     = invMass;
+    m_bodies.restitution[i] = rb.restitution;
+    m_bodies.friction[i]    = rb.friction;
+    m_bodies.dynamic[i]     = dynamic ? 1 : 0;
+
+    rb.force = { 0.0f, 0.0f, 0.0f };
+}
+
+// Semi-implicit Euler, split around the velocity solve.
+// w lanes stay intact: accel.w = velocity.w = 0.
+void PhysicsWorld::IntegrateVelocities(float dt)
+{
+    const XMVECTOR   vdt = XMVectorReplicate(dt);
+    XMFLOAT4A*       vel = m_bodies.velocity.data();
+    const XMFLOAT4A* acc = m_bodies.accel.data();
+    const uint8_t*   dyn = m_bodies.dynamic.data();
+
+    for (size_t i = 0, n = m_bodies.velocity.size(); i < n; ++i)
+    {
+        if (!dyn[i]) continue;
+        XMStoreFloat4A(&vel[i], XMVectorMultiplyAdd(XMLoadFloat4A(&acc[i]), vdt, XMLoadFloat4A(&vel[i])));
+    }
+}
+
+// Bodies that would move more than k_CcdMotionFraction of their radius are
+// left in place and queued for SweepFastBodies.
+void PhysicsWorld::IntegratePositions(float dt)
+{
+    const XMVECTOR   vdt = XMVectorReplicate(dt);
+    XMFLOAT4A*       pos = m_bodies.position.data();
+    const XMFLOAT4A* vel = m_bodies.velocity.data();
+    const uint8_t*   dyn = m_bodies.dynamic.data();
+
+    m_fastBodies.clear();
+    for (uint32_t i = 0, n = static_cast<uint32_t>(m_bodies.position.size()); i < n; ++i)
+    {
+        if (!dyn[i]) continue;
+        XMVECTOR v = XMLoadFloat4A(&vel[i]);
+        if (m_continuousCollision)
+        {
+            float reach = k_CcdMotionFraction * pos[i].w;
+            if (XMVectorGetX(XMVector3LengthSq(v)) * dt * dt > reach * reach)
+            {
+                m_fastBodies.push_back(i);
+                continue;
             }
-            addContact(n);
         }
+        XMStoreFloat4A(&pos[i], XMVectorMultiplyAdd(v, vdt, XMLoadFloat4A(&pos[i])));
     }
+}
 
-    // ---- Finalize contact normal ----
-    float len = Len(accNormal);
-    if (len > 1e-6f)
-        cc.contactNormal = Scale(accNormal, 1.0f / len);
+// Each sweep moves the body to its first time of impact, removes the approach
+// velocity there (with restitution, no friction — the next step's contacts
+// handle sliding) and carries on with the time left. Other spheres are treated
+// as stationary at their current positions; slow bodies have already moved.
+// Candidates come from this step's broadphase pairs. Serial, so a hit may
+// write the other body's velocity.
+void PhysicsWorld::SweepFastBodies(float dt)
+{
+    if (m_fastBodies.empty()) return;
+
+    // (fast body, other) for every pair touching a fast body, grouped by fast body.
+    // m_fastBodies is ascending, as IntegratePositions filled it.
+    m_sweepPairs.clear();
+    auto isFast = [this](uint32_t i) {
+        return std::binary_search(m_fastBodies.begin(), m_fastBodies.end(), i);
+    };
+    for (const auto& pr : m_pairs)
+    {
+        if (isFast(pr.a)) m_sweepPairs.push_back({ pr.a, pr.b });
+        if (isFast(pr.b)) m_sweepPairs.push_back({ pr.b, pr.a });
+    }
+    std::sort(m_sweepPairs.begin(), m_sweepPairs.end(),
+        [](const BroadphasePair& x, const BroadphasePair& y) { return x.a != y.a ? x.a < y.a : x.b < y.b; });
+
+    auto first = m_sweepPairs.begin();
+    for (uint32_t i : m_fastBodies)
+    {
+        while (first != m_sweepPairs.end() && first->a < i) ++first;
+        auto last = first;
+        while (last != m_sweepPairs.end() && last->a == i) ++last;
+
+        XMFLOAT4A&  pos       = m_bodies.position[i];
+        const float radius    = pos.w;
+        float       remaining = dt;
+
+        for (int sweep = 0; sweep < k_MaxCcdSweeps; ++sweep)
+        {
+            XMVECTOR v     = XMLoadFloat4A(&m_bodies.velocity[i]);
+            float    speed = XMVectorGetX(XMVector3Length(v));
+            float    dist  = speed * remaining;
+            if (dist < 1e-6f) break;
+
+            Ray ray;
+            ray.origin = { pos.x, pos.y, pos.z };
+            XMStoreFloat3(&ray.direction, XMVectorScale(v, 1.0f / speed));
+
+            SweepHit hit = {};
+            hit.t        = dist;
+            bool     found = SweepStatic(ray, radius, hit);
+            uint32_t other = k_NoBody;
+
+            for (auto it = first; it != last; ++it)
+            {
+                const uint32_t   j = it->b;
+                const XMFLOAT4A& q = m_bodies.position[j];
+                Sphere   s = { { q.x, q.y, q.z }, q.w };
+                float    t = 0.0f;
+                XMFLOAT3 n = {};
+                if (!SE::SphereCast(ray, radius, s, t, n) || t >= hit.t) continue;
+
+                found           = true;
+                other           = j;
+                hit.t           = t;
+                hit.normal      = n;
+                hit.restitution = m_bodies.restitution[j];
+            }
+
+            if (!found)
+            {
+                XMStoreFloat4A(&pos, XMVectorMultiplyAdd(v, XMVectorReplicate(remaining), XMLoadFloat4A(&pos)));
+                break;
+            }
+            ++m_stats.ccdHits;
+
+            // Stop just short of the surface so the next sweep doesn't start inside it.
+            XMFLOAT3 stop = ray.PointAt(fmaxf(hit.t - k_LinearSlop, 0.0f));
+            pos.x = stop.x; pos.y = stop.y; pos.z = stop.z;
+            remaining *= 1.0f - hit.t / dist;
+
+            // A sleeper in the way takes the hit as a body, not as a wall.
+            if (other != k_NoBody && m_spheres[other].body->sleeping)
+            {
+                m_spheres[other].body->WakeUp();
+                GatherBody(other);
+                --m_stats.sleeping;
+            }
+
+            XMVECTOR n  = XMLoadFloat3(&hit.normal);
+            XMVECTOR vo = other != k_NoBody ? XMLoadFloat4A(&m_bodies.velocity[other]) : XMVectorZero();
+            float    vN = XMVectorGetX(XMVector3Dot(XMVectorSubtract(v, vo), n));
+            float    ib = other != k_NoBody ? m_bodies.invMass[other] : 0.0f;
+            float    k  = m_bodies.invMass[i] + ib;
+            if (vN >= 0.0f) continue;
+
+            float e = hit.restitution * m_bodies.restitution[i];
+            if (other == k_NoBody || k <= 0.0f)
+            {
+                v = XMVectorSubtract(v, XMVectorScale(n, (1.0f + e) * vN));
+            }
+            else
+            {
+                float j = -(1.0f + e) * vN / k;
+                v  = XMVectorAdd(v, XMVectorScale(n, j * m_bodies.invMass[i]));
+                XMStoreFloat4A(&m_bodies.velocity[other], XMVectorSubtract(vo, XMVectorScale(n, j * ib)));
+            }
+            XMStoreFloat4A(&m_bodies.velocity[i], XMVectorSetW(v, 0.0f));
+        }
+        first = last;
+    }
 }
 
-void PhysicsWorld::Step(float /*dt*/)
+bool PhysicsWorld::SweepStatic(const Ray& ray, float radius, SweepHit& hit) const
 {
-    for (auto& s : m_spheres)
+    bool found = false;
+    auto take  = [&](float t, const XMFLOAT3& n, float restitution, RaycastHit::Kind kind)
     {
-        if (s.body->isStatic || !s.body->enabled) continue;
+        found           = true;
+        hit.t           = t;
+        hit.normal      = n;
+        hit.restitution = restitution;
+        hit.kind        = kind;
+    };
+
+    for (const auto& sp : m_planes)
+    {
+        float    t = 0.0f;
+        XMFLOAT3 n = {};
+        if (SE::SphereCast(ray, radius, sp.plane, t, n) && t < hit.t)
+            take(t, n, sp.restitution, RaycastHit::Kind::Plane);
+    }
+
+    auto testOBB = [&](uint32_t i, float tMax) -> float
+    {
+        float    t = 0.0f;
+        XMFLOAT3 n = {};
+        if (!SE::SphereCast(ray, radius, m_staticOBBs[i].obb, tMax, t, n) || t >= tMax) return tMax;
+        take(t, n, m_staticOBBs[i].restitution, RaycastHit::Kind::OBB);
+        return t;
+    };
+
+    // Same tree/tail split as Raycast; inflating the nodes by the radius turns
+    // the ray traversal into a sphere sweep.
+    uint32_t linearFrom = m_bvhNeedsRefit ? 0u : m_bvhPrimCount;
+    if (!m_bvhNeedsRefit)
+        m_staticBVH.QueryRay(ray, hit.t, testOBB, radius);
+    for (uint32_t i = linearFrom; i < static_cast<uint32_t>(m_staticOBBs.size()); ++i)
+        hit.t = testOBB(i, hit.t);
+
+    for (const auto& tm : m_triMeshes)
+    {
+        float    t = 0.0f;
+        XMFLOAT3 n = {};
+        if (tm.mesh->SphereCast(ray, radius, hit.t, t, n))
+            take(t, n, tm.restitution, RaycastHit::Kind::TriangleMesh);
+    }
 
-        for (const auto& p : m_planes)  ResolveSphereVsPlane(s, p);
-        for (const auto& o : m_staticOBBs) ResolveSphereVsOBB(s, o);
+    return found;
+}
+
+void PhysicsWorld::ScatterBodies()
+{
+    for (size_t i = 0; i < m_spheres.size(); ++i)
+    {
+        if (!m_bodies.dynamic[i]) continue; // nothing moved
+        const XMFLOAT4A& p = m_bodies.position[i];
+        const XMFLOAT4A& v = m_bodies.velocity[i];
+        m_spheres[i].transform->position = { p.x, p.y, p.z };
+        m_spheres[i].body->velocity      = { v.x, v.y, v.z };
     }
+}
 
+void PhysicsWorld::RebuildStaticHash()
+{
+    std::vector<AABB> bounds;
+    bounds.reserve(m_staticOBBs.size());
+    for (const auto& so : m_staticOBBs)
+        bounds.push_back(so.obb.GetAABB());
+    m_staticHash.Build(bounds.data(), static_cast<uint32_t>(bounds.size()));
+    m_staticDirty = false;
+}
+
+void PhysicsWorld::UpdateStaticBVH()
+{
+    if (m_bvhPrimCount != m_staticOBBs.size()) RebuildStaticBVH();
+    else if (m_bvhNeedsRefit)                  RefitStaticBVH();
+}
+
+void PhysicsWorld::GatherStaticOBBs(const AABB& box, std::vector<uint32_t>& out) const
+{
+    const size_t first = out.size();
+
+    uint32_t linearFrom = m_bvhNeedsRefit ? 0u : m_bvhPrimCount;
+    if (!m_bvhNeedsRefit)
+        m_staticBVH.QueryAABB(box, [&](uint32_t i) { out.push_back(i); });
+    for (uint32_t i = linearFrom; i < static_cast<uint32_t>(m_staticOBBs.size()); ++i)
+        if (m_staticOBBs[i].obb.GetAABB().Overlaps(box))
+            out.push_back(i);
+
+    // Resolve in insertion order, as the linear scan did.
+    std::sort(out.begin() + first, out.end());
+}
+
+// margin is added to the radius on every side.
+void PhysicsWorld::UpdateSphereBounds(float margin)
+{
+    m_sphereBounds.resize(m_spheres.size());
     for (size_t i = 0; i < m_spheres.size(); ++i)
-        for (size_t j = i + 1; j < m_spheres.size(); ++j)
-            ResolveSphereVsSphere(m_spheres[i], m_spheres[j]);
+    {
+        const XMFLOAT4A& p = m_bodies.position[i];
+        float r = p.w + margin;
+        m_sphereBounds[i] = AABB::FromCenterExtents({ p.x, p.y, p.z }, { r, r, r });
+    }
 }
 
-// ---- private ---------------------------------------------------------------
+void PhysicsWorld::CollideSphereVsPlane(uint32_t i, uint32_t planeIndex)
+{
+    const StaticPlane& sp = m_planes[planeIndex];
+    const XMFLOAT4A&   p  = m_bodies.position[i];
+    const XMFLOAT3&    n  = sp.plane.normal;
+    float dist = p.x * n.x + p.y * n.y + p.z * n.z - sp.plane.d;
+
+    if (dist >= p.w + k_Speculative) return; // no contact
 
-void PhysicsWorld::ResolveSphereVsPlane(SphereBody& s, const StaticPlane& sp)
+    Contact c       = {};
+    c.a             = i;
+    c.b             = k_NoBody;
+    c.key           = ContactKey(i, k_FeaturePlane, planeIndex);
+    c.normal        = n;
+    c.point         = { p.x - n.x * dist, p.y - n.y * dist, p.z - n.z * dist };
+    c.separation    = dist - p.w;
+    c.restitution   = sp.restitution * m_bodies.restitution[i];
+    c.friction      = sp.friction    * m_bodies.friction[i];
+    m_contacts.push_back(c);
+}
+
+void PhysicsWorld::CollideSphereVsPoint(uint32_t i, const XMFLOAT3& closest, uint64_t key,
+                                        float restitution, float friction)
 {
-    const XMFLOAT3& n   = sp.plane.normal;
-    float           dist = Dot(s.transform->position, n) - sp.plane.d;
+    XMVECTOR delta = XMVectorSubtract(XMLoadFloat4A(&m_bodies.position[i]), XMLoadFloat3(&closest));
+    delta          = XMVectorSetW(delta, 0.0f);
+    float    dist  = XMVectorGetX(XMVector3Length(delta));
 
-    if (dist >= s.radius) return; // no contact
+    if (dist >= m_bodies.position[i].w + k_Speculative) return;
 
-    // Positional correction — push sphere out of the plane.
-    float pen = s.radius - dist;
-    s.transform->position = Add(s.transform->position, Scale(n, pen));
+    XMVECTOR n = (dist < 1e-6f)
+        ? XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)
+        : XMVectorScale(delta, 1.0f / dist);
 
-    // Only resolve if moving into the plane.
-    float vN = Dot(s.body->velocity, n);
-    if (vN >= 0.0f) return;
+    Contact c       = {};
+    c.a             = i;
+    c.b             = k_NoBody;
+    c.key           = key;
+    c.point         = closest;
+    c.separation    = dist - m_bodies.position[i].w;
+    c.restitution   = restitution * m_bodies.restitution[i];
+    c.friction      = friction    * m_bodies.friction[i];
+    XMStoreFloat3(&c.normal, n);
+    m_contacts.push_back(c);
+}
 
-    // Normal impulse with restitution.
-    float e = sp.restitution * s.body->restitution;
-    s.body->velocity = Add(s.body->velocity, Scale(n, -(1.0f + e) * vN));
+void PhysicsWorld::CollideSphereVsSphere(uint32_t a, uint32_t b)
+{
+    if (!m_bodies.dynamic[a] && !m_bodies.dynamic[b]) return;
 
-    // Friction: damp the tangential component.
-    XMFLOAT3 newN  = Scale(n, Dot(s.body->velocity, n));
-    XMFLOAT3 vTan  = Sub(s.body->velocity, newN);
-    float     mu   = sp.friction * s.body->friction;
-    s.body->velocity = Add(newN, Scale(vTan, 1.0f - mu));
+    XMVECTOR delta = XMVectorSubtract(XMLoadFloat4A(&m_bodies.position[a]),
+                                      XMLoadFloat4A(&m_bodies.position[b]));
+    delta          = XMVectorSetW(delta, 0.0f);
+    float    dist  = XMVectorGetX(XMVector3Length(delta));
+    float    sumR  = m_bodies.position[a].w + m_bodies.position[b].w;
+
+    if (dist >= sumR + k_Speculative || dist < 1e-6f) return;
+
+    Contact c       = {};
+    c.a             = a;
+    c.b             = b;
+    c.key           = ContactKey(a, k_FeatureSphere, b);
+    c.separation    = dist - sumR;
+    c.restitution   = m_bodies.restitution[a] * m_bodies.restitution[b];
+    c.friction      = m_bodies.friction[a]    * m_bodies.friction[b];
+    XMStoreFloat3(&c.normal, XMVectorScale(delta, 1.0f / dist));
+    m_contacts.push_back(c);
 }
 
-void PhysicsWorld::ResolveSphereVsSphere(SphereBody& a, SphereBody& b)
+// The mover's velocity is the one it entered the step with, so a body woken
+// here (velocity zero) doesn't wake its neighbours in turn; the rest of a pile
+// wakes as the disturbance actually spreads.
+void PhysicsWorld::WakeTouchedBodies(float dt)
 {
-    if ((a.body->isStatic || !a.body->enabled) &&
-        (b.body->isStatic || !b.body->enabled)) return;
+    for (const auto& pr : m_pairs)
+    {
+        uint32_t mover = pr.a, sleeper = pr.b;
+        if (!m_bodies.dynamic[mover]) { mover = pr.b; sleeper = pr.a; }
+        if (!m_bodies.dynamic[mover] || m_bodies.dynamic[sleeper]) continue;
 
-    XMFLOAT3 delta = Sub(b.transform->position, a.transform->position);
-    float     dist  = Len(delta);
-    float     sumR  = a.radius + b.radius;
+        RigidBodyComponent& rb = *m_spheres[sleeper].body;
+        const XMFLOAT3&     v  = m_spheres[mover].body->velocity;
+        if (!rb.sleeping || Dot(v, v) <= k_SleepSpeed * k_SleepSpeed) continue;
 
-    if (dist >= sumR || dist < 1e-6f) return;
+        XMVECTOR delta = XMVectorSubtract(XMLoadFloat4A(&m_bodies.position[mover]),
+                                          XMLoadFloat4A(&m_bodies.position[sleeper]));
+        float dist = XMVectorGetX(XMVector3Length(XMVectorSetW(delta, 0.0f)));
+        if (dist >= m_bodies.position[mover].w + m_bodies.position[sleeper].w + k_Speculative) continue;
 
-    XMFLOAT3 n   = Scale(delta, 1.0f / dist);
-    float     pen = sumR - dist;
+        rb.WakeUp();
+        GatherBody(sleeper);
+        XMStoreFloat4A(&m_bodies.velocity[sleeper],
+            XMVectorMultiplyAdd(XMLoadFloat4A(&m_bodies.accel[sleeper]), XMVectorReplicate(dt),
+                                XMLoadFloat4A(&m_bodies.velocity[sleeper])));
+        --m_stats.sleeping;
+    }
+}
 
-    // Positional correction split by inverse mass.
-    float invMA = a.body->isStatic ? 0.0f : 1.0f / a.body->mass;
-    float invMB = b.body->isStatic ? 0.0f : 1.0f / b.body->mass;
-    float invSum = invMA + invMB;
-    if (invSum < 1e-9f) return;
+// An island sleeps as a whole or not at all, so a pile never freezes around
+// a body that is still settling.
+void PhysicsWorld::UpdateSleep()
+{
+    const uint32_t count = static_cast<uint32_t>(m_spheres.size());
+    m_sleepReady.assign(count, 0);
 
-    a.transform->position = Sub(a.transform->position, Scale(n, pen * invMA / invSum));
-    b.transform->position = Add(b.transform->position, Scale(n, pen * invMB / invSum));
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!m_bodies.dynamic[i]) continue;
+        RigidBodyComponent& rb = *m_spheres[i].body;
+        const XMFLOAT4A&    v  = m_bodies.velocity[i];
+        if (rb.canSleep && v.x * v.x + v.y * v.y + v.z * v.z < k_SleepSpeed * k_SleepSpeed)
+        {
+            if (++rb.restSteps >= k_SleepSteps) m_sleepReady[i] = 1;
+        }
+        else rb.restSteps = 0;
+    }
 
-    // Relative velocity along normal.
-    XMFLOAT3 relVel = Sub(b.body->velocity, a.body->velocity);
-    float     vN    = Dot(relVel, n);
-    if (vN >= 0.0f) return; // separating
+    for (const Island& island : m_islands)
+    {
+        bool ready = true;
+        for (uint32_t k = island.first; k < island.first + island.count && ready; ++k)
+        {
+            const Contact& c = m_contacts[m_islandContacts[k]];
+            ready = (!m_bodies.dynamic[c.a] || m_sleepReady[c.a]) &&
+                    (c.b == k_NoBody || !m_bodies.dynamic[c.b] || m_sleepReady[c.b]);
+        }
+        if (ready) continue;
+        for (uint32_t k = island.first; k < island.first + island.count; ++k)
+        {
+            const Contact& c = m_contacts[m_islandContacts[k]];
+            m_sleepReady[c.a] = 0;
+            if (c.b != k_NoBody) m_sleepReady[c.b] = 0;
+        }
+    }
 
-    float e = a.body->restitution * b.body->restitution;
-    float j = -(1.0f + e) * vN / invSum;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!m_sleepReady[i]) continue;
+        m_spheres[i].body->sleeping = true;
+        m_bodies.velocity[i]        = { 0.0f, 0.0f, 0.0f, 0.0f };
+        ++m_stats.sleeping;
+    }
+}
 
-    a.body->velocity = Sub(a.body->velocity, Scale(n, j * invMA));
-    b.body->velocity = Add(b.body->velocity, Scale(n, j * invMB));
+void PhysicsWorld::ApplyWarmStart()
+{
+    for (Contact& c : m_contacts)
+    {
+        auto it = std::lower_bound(m_warmStart.begin(), m_warmStart.end(), c.key,
+            [](const CachedImpulse& ci, uint64_t key) { return ci.key < key; });
+        if (it == m_warmStart.end() || it->key != c.key) continue;
+        c.normalImpulse  = it->normalImpulse;
+        c.tangentImpulse = it->tangentImpulse;
+    }
+}
+
+void PhysicsWorld::StoreWarmStart()
+{
+    m_warmStart.resize(m_contacts.size());
+    for (size_t k = 0; k < m_contacts.size(); ++k)
+        m_warmStart[k] = { m_contacts[k].key, m_contacts[k].normalImpulse, m_contacts[k].tangentImpulse };
+    std::sort(m_warmStart.begin(), m_warmStart.end(),
+        [](const CachedImpulse& x, const CachedImpulse& y) { return x.key < y.key; });
 }
 
-void PhysicsWorld::ResolveSphereVsOBB(SphereBody& s, const StaticOBB& so)
+// Union-find over the dynamic bodies each contact touches; static surfaces and
+// immovable bodies never join islands. Islands are numbered by first contact
+// and keep contacts in generation order, so the solve order is fixed.
+void PhysicsWorld::BuildIslands()
 {
-    const OBB&    obb = so.obb;
-    const XMFLOAT3& C = s.transform->position;
+    const uint32_t bodyCount = static_cast<uint32_t>(m_spheres.size());
+    auto& parent = m_islandParent;
+    parent.resize(bodyCount);
+    for (uint32_t i = 0; i < bodyCount; ++i) parent[i] = i;
 
-    // Closest point on OBB to sphere centre.
-    XMFLOAT3 d       = Sub(C, obb.center);
-    XMFLOAT3 closest = obb.center;
-    for (int i = 0; i < 3; ++i)
+    auto find = [&](uint32_t x) {
+        while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+        return x;
+    };
+
+    for (const Contact& c : m_contacts)
     {
-        float proj = Dot(d, obb.axes[i]);
-        float he   = (&obb.halfExtents.x)[i];
-        float p    = proj < -he ? -he : (proj > he ? he : proj);
-        closest.x += p * obb.axes[i].x;
-        closest.y += p * obb.axes[i].y;
-        closest.z += p * obb.axes[i].z;
+        if (c.b == k_NoBody || m_bodies.invMass[c.a] == 0.0f || m_bodies.invMass[c.b] == 0.0f)
+            continue;
+        uint32_t ra = find(c.a), rb = find(c.b);
+        if (ra < rb) parent[rb] = ra;
+        else         parent[ra] = rb;
     }
 
-    XMFLOAT3 delta = Sub(C, closest);
-    float     dist  = Len(delta);
+    m_islands.clear();
+    m_islandOfBody.assign(bodyCount, k_NoBody);
+    std::vector<uint32_t>& contactIsland = m_contactIsland;
+    contactIsland.resize(m_contacts.size());
 
-    if (dist >= s.radius) return;
+    for (size_t k = 0; k < m_contacts.size(); ++k)
+    {
+        const Contact& c = m_contacts[k];
+        uint32_t body = m_bodies.invMass[c.a] > 0.0f ? c.a : c.b;
+        if (body == k_NoBody || m_bodies.invMass[body] == 0.0f)
+        {
+            contactIsland[k] = k_NoBody; // nothing movable — skip
+            continue;
+        }
+        uint32_t root = find(body);
+        if (m_islandOfBody[root] == k_NoBody)
+        {
+            m_islandOfBody[root] = static_cast<uint32_t>(m_islands.size());
+            m_islands.push_back({ 0, 0 });
+        }
+        contactIsland[k] = m_islandOfBody[root];
+        ++m_islands[contactIsland[k]].count;
+    }
 
-    XMFLOAT3 n = (dist < 1e-6f)
-        ? XMFLOAT3{ 0.0f, 1.0f, 0.0f }
-        : Scale(delta, 1.0f / dist);
+    // Counting sort of contact indices by island.
+    uint32_t offset = 0;
+    for (Island& island : m_islands) { island.first = offset; offset += island.count; island.count = 0; }
 
-    float pen = s.radius - dist;
-    s.transform->position = Add(s.transform->position, Scale(n, pen));
+    m_islandContacts.resize(offset);
+    for (size_t k = 0; k < m_contacts.size(); ++k)
+    {
+        if (contactIsland[k] == k_NoBody) continue;
+        Island& island = m_islands[contactIsland[k]];
+        m_islandContacts[island.first + island.count++] = static_cast<uint32_t>(k);
+    }
+
+    // Big islands first so one doesn't start last and hold up the whole step.
+    m_islandOrder.resize(m_islands.size());
+    for (uint32_t k = 0; k < static_cast<uint32_t>(m_islands.size()); ++k) m_islandOrder[k] = k;
+    // Ties broken by id rather than stable_sort, which allocates a buffer per call.
+    std::sort(m_islandOrder.begin(), m_islandOrder.end(), [this](uint32_t x, uint32_t y) {
+        return m_islands[x].count != m_islands[y].count ? m_islands[x].count > m_islands[y].count : x < y;
+    });
+}
 
-    float vN = Dot(s.body->velocity, n);
-    if (vN >= 0.0f) return;
+// Sequential impulses with accumulated clamping (Catto), warm-started from the
+// previous step. Touches only the bodies and contacts of this island.
+void PhysicsWorld::SolveIslandVelocities(const Island& island, float dt)
+{
+    const uint32_t* indices = m_islandContacts.data() + island.first;
+    XMFLOAT4A*      vel     = m_bodies.velocity.data();
+    const float*    invMass = m_bodies.invMass.data();
+
+    auto relVel = [&](const Contact& c) {
+        XMVECTOR v = XMLoadFloat4A(&vel[c.a]);
+        if (c.b != k_NoBody) v = XMVectorSubtract(v, XMLoadFloat4A(&vel[c.b]));
+        return v;
+    };
+    // Apply impulse j to a and -j to b. Immovable sides are never written.
+    auto applyImpulse = [&](const Contact& c, FXMVECTOR j) {
+        float ia = invMass[c.a];
+        float ib = c.b != k_NoBody ? invMass[c.b] : 0.0f;
+        if (ia > 0.0f)
+            XMStoreFloat4A(&vel[c.a], XMVectorMultiplyAdd(j, XMVectorReplicate(ia), XMLoadFloat4A(&vel[c.a])));
+        if (ib > 0.0f)
+            XMStoreFloat4A(&vel[c.b], XMVectorNegativeMultiplySubtract(j, XMVectorReplicate(ib), XMLoadFloat4A(&vel[c.b])));
+    };
+    auto effMass = [&](const Contact& c) {
+        float k = invMass[c.a] + (c.b != k_NoBody ? invMass[c.b] : 0.0f);
+        return k > 0.0f ? 1.0f / k : 0.0f;
+    };
 
-    float e = so.restitution * s.body->restitution;
-    s.body->velocity = Add(s.body->velocity, Scale(n, -(1.0f + e) * vN));
+    // Pre-step: target normal speed. A speculative contact
+    // (still apart) may close its gap this step but no more; a touching one
+    // bounces if it hit hard enough.
+    const float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+    for (uint32_t k = 0; k < island.count; ++k)
+    {
+        Contact& c  = m_contacts[indices[k]];
+        XMVECTOR n  = XMLoadFloat3(&c.normal);
+        float    vN = XMVectorGetX(XMVector3Dot(relVel(c), n));
+        if (c.separation > 0.0f)
+            c.bias = -c.separation * invDt;
+        else
+            c.bias = vN < -k_RestitutionThreshold ? -c.restitution * vN : 0.0f;
+    }
 
-    XMFLOAT3 newN = Scale(n, Dot(s.body->velocity, n));
-    XMFLOAT3 vTan = Sub(s.body->velocity, newN);
-    float     mu  = so.friction * s.body->friction;
-    s.body->velocity = Add(newN, Scale(vTan, 1.0f - mu));
+    // Warm start only after every bias has seen the pre-solve velocities.
+    for (uint32_t k = 0; k < island.count; ++k)
+    {
+        Contact& c = m_contacts[indices[k]];
+        XMVECTOR n = XMLoadFloat3(&c.normal);
+
+        // Keep only the part of the old friction impulse that lies in the new tangent plane.
+        XMVECTOR t = XMLoadFloat3(&c.tangentImpulse);
+        t = XMVectorNegativeMultiplySubtract(n, XMVector3Dot(t, n), t);
+        XMStoreFloat3(&c.tangentImpulse, t);
+        applyImpulse(c, XMVectorMultiplyAdd(n, XMVectorReplicate(c.normalImpulse), t));
+    }
+
+    for (uint32_t it = 0; it < m_velocityIterations; ++it)
+    {
+        for (uint32_t k = 0; k < island.count; ++k)
+        {
+            Contact& c    = m_contacts[indices[k]];
+            XMVECTOR n    = XMLoadFloat3(&c.normal);
+            float    mass = effMass(c);
+
+            // Normal: push apart until the separating speed reaches bias.
+            float vN     = XMVectorGetX(XMVector3Dot(relVel(c), n));
+            float oldJ   = c.normalImpulse;
+            c.normalImpulse = fmaxf(oldJ + (c.bias - vN) * mass, 0.0f);
+            applyImpulse(c, XMVectorScale(n, c.normalImpulse - oldJ));
+
+            // Friction: cancel sliding, bounded by the Coulomb cone.
+            XMVECTOR v    = relVel(c);
+            XMVECTOR vTan = XMVectorNegativeMultiplySubtract(n, XMVector3Dot(v, n), v);
+            XMVECTOR oldT = XMLoadFloat3(&c.tangentImpulse);
+            XMVECTOR newT = XMVectorNegativeMultiplySubtract(vTan, XMVectorReplicate(mass), oldT);
+            float    maxT = c.friction * c.normalImpulse;
+            float    lenT = XMVectorGetX(XMVector3Length(newT));
+            if (lenT > maxT) newT = XMVectorScale(newT, lenT > 0.0f ? maxT / lenT : 0.0f);
+            XMStoreFloat3(&c.tangentImpulse, newT);
+            applyImpulse(c, XMVectorSubtract(newT, oldT));
+        }
+    }
+}
+
+// Direct positional correction of leftover penetration. Works on the current
+// positions, so contacts that share a body (e.g. neighbouring floor triangles)
+// don't push it out twice.
+void PhysicsWorld::SolveIslandPositions(const Island& island)
+{
+    const uint32_t* indices = m_islandContacts.data() + island.first;
+    XMFLOAT4A*      pos     = m_bodies.position.data();
+    const float*    invMass = m_bodies.invMass.data();
+
+    auto effMass = [&](const Contact& c) {
+        float k = invMass[c.a] + (c.b != k_NoBody ? invMass[c.b] : 0.0f);
+        return k > 0.0f ? 1.0f / k : 0.0f;
+    };
+
+    for (uint32_t it = 0; it < m_positionIterations; ++it)
+    {
+        for (uint32_t k = 0; k < island.count; ++k)
+        {
+            const Contact& c  = m_contacts[indices[k]];
+            XMVECTOR pa = XMLoadFloat4A(&pos[c.a]);
+            XMVECTOR n;
+            float    pen;
+            if (c.b == k_NoBody)
+            {
+                n   = XMLoadFloat3(&c.normal);
+                pen = pos[c.a].w - XMVectorGetX(XMVector3Dot(XMVectorSubtract(pa, XMLoadFloat3(&c.point)), n));
+            }
+            else
+            {
+                XMVECTOR d    = XMVectorSetW(XMVectorSubtract(pa, XMLoadFloat4A(&pos[c.b])), 0.0f);
+                float    dist = XMVectorGetX(XMVector3Length(d));
+                if (dist < 1e-6f) continue;
+                n   = XMVectorScale(d, 1.0f / dist);
+                pen = pos[c.a].w + pos[c.b].w - dist;
+            }
+            if (pen <= k_LinearSlop) continue;
+
+            XMVECTOR corr = XMVectorScale(n, k_PositionBeta * (pen - k_LinearSlop) * effMass(c));
+            float ia = invMass[c.a];
+            float ib = c.b != k_NoBody ? invMass[c.b] : 0.0f;
+            if (ia > 0.0f) XMStoreFloat4A(&pos[c.a], XMVectorMultiplyAdd(corr, XMVectorReplicate(ia), pa));
+            if (ib > 0.0f) XMStoreFloat4A(&pos[c.b], XMVectorNegativeMultiplySubtract(corr, XMVectorReplicate(ib), XMLoadFloat4A(&pos[c.b])));
+        }
+    }
 }
 
 } // namespace SE
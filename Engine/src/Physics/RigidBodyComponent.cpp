@@ -4,10 +4,9 @@
 
 namespace SE {
 
-static constexpr float kGravity = -9.81f;
-
 void RigidBodyComponent::AddForce(DirectX::XMFLOAT3 f)
 {
+    WakeUp();
     force.x += f.x;
     force.y += f.y;
     force.z += f.z;
@@ -15,6 +14,7 @@ void RigidBodyComponent::AddForce(DirectX::XMFLOAT3 f)
 
 void RigidBodyComponent::AddImpulse(DirectX::XMFLOAT3 impulse)
 {
+    WakeUp();
     velocity.x += impulse.x;
     velocity.y += impulse.y;
     velocity.z += impulse.z;
@@ -22,10 +22,13 @@ void RigidBodyComponent::AddImpulse(DirectX::XMFLOAT3 impulse)
 
 void RigidBodyComponent::Update(float dt)
 {
-    if (isStatic || !enabled) return;
+    if (auto* t = GetOwner()->GetComponent<TransformComponent>())
+        Integrate(*t, dt);
+}
 
-    auto* t = GetOwner()->GetComponent<TransformComponent>();
-    if (!t) return;
+void RigidBodyComponent::Integrate(TransformComponent& t, float dt)
+{
+    if (isStatic || !enabled || simulatedByWorld || sleeping) return;
 
     if (useGravity)
         force.y += kGravity * mass;
@@ -36,9 +39,9 @@ void RigidBodyComponent::Update(float dt)
     velocity.y += force.y * invMass * dt;
     velocity.z += force.z * invMass * dt;
 
-    t->position.x += velocity.x * dt;
-    t->position.y += velocity.y * dt;
-    t->position.z += velocity.z * dt;
+    t.position.x += velocity.x * dt;
+    t.position.y += velocity.y * dt;
+    t.position.z += velocity.z * dt;
 
     force = { 0.0f, 0.0f, 0.0f };
 }
@@ -0,0 +1,175 @@
+#include "Engine/Physics/TriangleMesh.h"
+#include "Engine/Physics/Intersect.h"
+#include <cfloat>
+#include <cmath>
+
+namespace SE {
+
+using namespace DirectX;
+
+static XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x-b.x, a.y-b.y, a.z-b.z }; }
+static float    Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x*b.x + a.y*b.y + a.z*b.z; }
+static XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+{
+    return { a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z, a.x*b.y - a.y*b.x };
+}
+static XMFLOAT3 Madd(const XMFLOAT3& a, const XMFLOAT3& d, float s)
+{
+    return { a.x + d.x*s, a.y + d.y*s, a.z + d.z*s };
+}
+
+void TriangleMesh::Build(const XMFLOAT3* positions, uint32_t vertexCount,
+                         const uint32_t* indices, uint32_t indexCount,
+                         FXMMATRIX world)
+{
+    m_triangles.clear();
+    m_bvh.Clear();
+    m_bounds = AABB{};
+
+    std::vector<XMFLOAT3> worldPos(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+        XMStoreFloat3(&worldPos[i], XMVector3TransformCoord(XMLoadFloat3(&positions[i]), world));
+
+    std::vector<Triangle> tris;
+    tris.reserve(indexCount / 3);
+    for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+            continue;
+        Triangle t = { worldPos[indices[i]], worldPos[indices[i + 1]], worldPos[indices[i + 2]] };
+        XMFLOAT3 n = Cross(Sub(t.v1, t.v0), Sub(t.v2, t.v0));
+        if (Dot(n, n) < 1e-12f) continue; // zero area — no normal, can't collide sensibly
+        tris.push_back(t);
+    }
+
+    std::vector<AABB> bounds(tris.size());
+    for (size_t i = 0; i < tris.size(); ++i)
+    {
+        bounds[i].Expand(tris[i].v0);
+        bounds[i].Expand(tris[i].v1);
+        bounds[i].Expand(tris[i].v2);
+        m_bounds.Expand(bounds[i].min);
+        m_bounds.Expand(bounds[i].max);
+    }
+
+    m_bvh.Build(bounds.data(), static_cast<uint32_t>(bounds.size()));
+
+    // Store triangles in leaf order, then let the tree index them directly.
+    const auto& order = m_bvh.GetPrimIndices();
+    m_triangles.resize(tris.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        m_triangles[i] = tris[order[i]];
+    m_bvh.AdoptLeafOrder();
+}
+
+bool TriangleMesh::Raycast(const Ray& ray, float tMax, float& t, XMFLOAT3& normal) const
+{
+    const Triangle* hit = nullptr;
+
+    // Möller–Trumbore, two-sided.
+    m_bvh.QueryRay(ray, tMax, [&](uint32_t i, float maxT) -> float
+    {
+        const Triangle& tri = m_triangles[i];
+        XMFLOAT3 e1  = Sub(tri.v1, tri.v0);
+        XMFLOAT3 e2  = Sub(tri.v2, tri.v0);
+        XMFLOAT3 p   = Cross(ray.direction, e2);
+        float    det = Dot(e1, p);
+        if (fabsf(det) < 1e-10f) return maxT;
+
+        float    inv = 1.0f / det;
+        XMFLOAT3 s   = Sub(ray.origin, tri.v0);
+        float    u   = Dot(s, p) * inv;
+        if (u < 0.0f || u > 1.0f) return maxT;
+        XMFLOAT3 q   = Cross(s, e1);
+        float    v   = Dot(ray.direction, q) * inv;
+        if (v < 0.0f || u + v > 1.0f) return maxT;
+        float    th  = Dot(e2, q) * inv;
+        if (th < 0.0f || th >= maxT) return maxT;
+
+        hit = &tri;
+        t   = th;
+        return th;
+    });
+
+    if (!hit) return false;
+
+    XMFLOAT3 n = Cross(Sub(hit->v1, hit->v0), Sub(hit->v2, hit->v0));
+    if (Dot(n, ray.direction) > 0.0f) n = { -n.x, -n.y, -n.z };
+    XMStoreFloat3(&normal, XMVector3Normalize(XMLoadFloat3(&n)));
+    return true;
+}
+
+bool TriangleMesh::SphereCast(const Ray& ray, float radius, float tMax, float& t, XMFLOAT3& normal) const
+{
+    bool found = false;
+    m_bvh.QueryRay(ray, tMax, [&](uint32_t i, float maxT) -> float
+    {
+        const Triangle& tri = m_triangles[i];
+        float    th;
+        XMFLOAT3 n;
+        if (!SphereCastConvex(ray, radius, maxT,
+                [&](const XMFLOAT3& p) { return ClosestPointOnTriangle(p, tri); }, th, n)
+            || th >= maxT)
+            return maxT;
+
+        found  = true;
+        t      = th;
+        normal = n;
+        return th;
+    }, radius);
+    return found;
+}
+
+bool TriangleMesh::ClosestPoint(XMFLOAT3 p, float maxDist, XMFLOAT3& closest) const
+{
+    bool found = false;
+    m_bvh.QueryClosest(p, maxDist * maxDist, [&](uint32_t i, float maxSq) -> float
+    {
+        XMFLOAT3 c = ClosestPointOnTriangle(p, m_triangles[i]);
+        XMFLOAT3 d = Sub(p, c);
+        float    dSq = Dot(d, d);
+        if (dSq > maxSq) return maxSq;
+        closest = c;
+        found   = true;
+        return dSq;
+    });
+    return found;
+}
+
+// Ericson, Real-Time Collision Detection §5.1.5 — Voronoi region classification.
+XMFLOAT3 TriangleMesh::ClosestPointOnTriangle(const XMFLOAT3& p, const Triangle& tri)
+{
+    const XMFLOAT3& a = tri.v0;
+    const XMFLOAT3& b = tri.v1;
+    const XMFLOAT3& c = tri.v2;
+
+    XMFLOAT3 ab = Sub(b, a), ac = Sub(c, a), ap = Sub(p, a);
+    float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    XMFLOAT3 bp = Sub(p, b);
+    float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return Madd(a, ab, d1 / (d1 - d3));
+
+    XMFLOAT3 cp = Sub(p, c);
+    float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return Madd(a, ac, d2 / (d2 - d6));
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return Madd(b, Sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    float denom = 1.0f / (va + vb + vc);
+    float v = vb * denom, w = vc * denom;
+    return Madd(Madd(a, ab, v), ac, w);
+}
+
+} // namespace SE
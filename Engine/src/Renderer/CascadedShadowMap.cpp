@@ -107,7 +107,9 @@ bool CascadedShadowMap::Init(ID3D11Device* device, ShaderLibrary& shaders, uint3
     rsDesc.DepthBias             = 4000;
     rsDesc.DepthBiasClamp        = 0.0f;
     rsDesc.SlopeScaledDepthBias  = 2.0f;
-    rsDesc.DepthClipEnable       = TRUE;
+    // Casters culled against GetCasterFrustum may lie in front of the near
+    // plane; without clipping they are clamped to depth 0 and still shadow.
+    rsDesc.DepthClipEnable       = FALSE;
     SE_HR(device->CreateRasterizerState(&rsDesc, &m_shadowRS));
 
     // Unit sphere
@@ -208,6 +210,9 @@ void CascadedShadowMap::Update(XMFLOAT3 lightDir,
             minX, maxX, minY, maxY, minZ, maxZ);
 
         m_cascadeVP[c] = XMMatrixMultiply(lightView, lightProj);
+
+        m_casterFrustum[c].ExtractFromVP(m_cascadeVP[c]);
+        m_casterFrustum[c].planes[4] = { 0.0f, 0.0f, 0.0f, 1.0f }; // near: always in front
     }
 }
 
@@ -242,15 +247,38 @@ void CascadedShadowMap::BeginCascade(ID3D11DeviceContext* ctx, int cascade)
 }
 
 void CascadedShadowMap::DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATRIX model)
+{
+    BindModel(ctx, model);
+    for (uint32_t i = 0; i < mesh.GetSubMeshCount(); ++i)
+        mesh.DrawSubMesh(ctx, i);
+}
+
+void CascadedShadowMap::DrawSubMeshes(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATRIX model,
+                                      const uint32_t* subMeshes, uint32_t count)
+{
+    BindModel(ctx, model);
+    for (uint32_t i = 0; i < count; ++i)
+        mesh.DrawSubMesh(ctx, subMeshes[i]);
+}
+
+void CascadedShadowMap::DrawCasters(ID3D11DeviceContext* ctx, const VisibilityIndex& index)
+{
+    m_casters.clear();
+    index.QueryFrustum(m_casterFrustum[m_currentCascade], m_casters);
+    m_casterStats[m_currentCascade] = index.ForEachCaster(m_casters,
+        [&](const VisibilityIndex::Object& o, const uint32_t* subMeshes, uint32_t count)
+        {
+            DrawSubMeshes(ctx, *o.mesh, XMLoadFloat4x4(&o.world), subMeshes, count);
+        });
+}
+
+void CascadedShadowMap::BindModel(ID3D11DeviceContext* ctx, XMMATRIX model)
 {
     ShadowCBData cb;
     XMStoreFloat4x4(&cb.model, model);
     XMStoreFloat4x4(&cb.viewProj, m_cascadeVP[m_currentCascade]);
     m_cb.Update(ctx, cb);
     m_cb.BindVS(ctx, 0);
-
-    for (uint32_t i = 0; i < mesh.GetSubMeshCount(); ++i)
-        mesh.DrawSubMesh(ctx, i);
 }
 
 void CascadedShadowMap::DrawSphere(ID3D11DeviceContext* ctx, XMFLOAT3 position, float radius)
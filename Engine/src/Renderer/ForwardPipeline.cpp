@@ -1,5 +1,6 @@
 #include "Engine/Renderer/ForwardPipeline.h"
 #include "Engine/Core/Logger.h"
+#include "Engine/Renderer/VisibilityIndex.h"
 #include <windows.h>
 #include <d3dcompiler.h>
 #include <cmath>
@@ -110,8 +111,10 @@ void BuildSphereMesh(float radius, int rings, int segs,
 
 } // anonymous namespace
 
-bool ForwardPipeline::Init(ID3D11Device* device, AssetManager& assets, ShaderLibrary& shaders)
+bool ForwardPipeline::Init(ID3D11Device* device, AssetManager& assets, ShaderLibrary& shaders, FrameArena& frameArena)
 {
+    m_frameArena = &frameArena;
+
     const ShaderPermutation* perm = shaders.Get(L"Shaders/Basic.hlsl");
     if (!perm)
     {
@@ -223,23 +226,19 @@ bool ForwardPipeline::Init(ID3D11Device* device, AssetManager& assets, ShaderLib
 
 std::vector<ForwardPipeline::SubMat> ForwardPipeline::LoadMeshMaterials(AssetManager& assets, const Mesh& mesh)
 {
-    auto toWide = [](const std::string& s) -> std::wstring {
-        return std::wstring(s.begin(), s.end());
-    };
-
-    // Extract filename stem and force .dds extension, stripping any embedded directory.
-    auto stemDDS = [](const std::string& raw) -> std::string {
-        std::string p = raw;
-        for (auto& c : p) if (c == '\\') c = '/';
-        auto slash = p.rfind('/');
-        std::string name = (slash != std::string::npos) ? p.substr(slash + 1) : p;
-        auto dot = name.rfind('.');
-        return (dot != std::string::npos ? name.substr(0, dot) : name) + ".dds";
-    };
-
     const std::string& dir = mesh.GetDirectory();
     std::vector<SubMat> mats(mesh.GetSubMeshCount());
 
+    // One path buffer for every lookup, rebuilt in place.
+    std::wstring path;
+    auto tryTexture = [&](const char* subDir, const std::string& raw, size_t stem, size_t stemEnd) {
+        path.assign(dir.begin(), dir.end());
+        for (const char* c = subDir; *c; ++c) path.push_back(static_cast<wchar_t>(*c));
+        path.append(raw.begin() + stem, raw.begin() + stemEnd);
+        path.append(L".dds");
+        return assets.GetTexture(path);
+    };
+
     for (uint32_t i = 0; i < mesh.GetSubMeshCount(); ++i)
     {
         SubMeshInfo info = mesh.GetSubMeshInfo(i);
@@ -247,10 +246,14 @@ std::vector<ForwardPipeline::SubMat> ForwardPipeline::LoadMeshMaterials(AssetMan
 
         auto loadTex = [&](const std::string& rawPath) -> AssetHandle<Texture2D> {
             if (rawPath.empty()) return nullptr;
-            std::string dds = stemDDS(rawPath);
+            // Filename stem with the extension forced to .dds, stripping any embedded directory.
+            const size_t slash = rawPath.find_last_of("/\\");
+            const size_t stem  = (slash != std::string::npos) ? slash + 1 : 0;
+            size_t       dot   = rawPath.rfind('.');
+            if (dot == std::string::npos || dot < stem) dot = rawPath.size();
             // Try mesh-local Textures/ subdir first, then mesh root dir.
-            auto h = assets.GetTexture(toWide(dir + "Textures/" + dds));
-            if (!h) h = assets.GetTexture(toWide(dir + dds));
+            auto h = tryTexture("Textures/", rawPath, stem, dot);
+            if (!h) h = tryTexture("", rawPath, stem, dot);
             return h;
         };
 
@@ -279,9 +282,15 @@ void ForwardPipeline::Begin(ID3D11DeviceContext* ctx, DirectX::XMMATRIX view, Di
     m_view = view;
     m_proj = proj;
     m_frustum.ExtractFromVP(DirectX::XMMatrixMultiply(view, proj));
-    m_queue.Clear();
-    m_queuedDraws.clear();
-    m_lastCulled = 0;
+
+    // Both queues are rebuilt in this frame's arena, sized from last frame.
+    LinearArena& arena     = m_frameArena->Current();
+    const size_t lastDraws = m_queuedDraws.size();
+    m_queue.Clear(&arena);
+    m_queuedDraws = ArenaVector<QueuedDraw>(ArenaAllocator<QueuedDraw>(&arena));
+    m_queuedDraws.reserve(lastDraws);
+    m_lastCulled  = 0;
+    m_lastVisible = 0;
 
     m_sampler.BindPS(ctx, 0);
     ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -351,6 +360,21 @@ void ForwardPipeline::SubmitMesh(const Mesh& mesh, DirectX::XMMATRIX model,
         }
     }
 
+    // Part of the mesh is in view; cull its submeshes individually so a large
+    // multi-part mesh (Bistro) only queues what the camera can see.
+    const uint32_t subCount = mesh.GetSubMeshCount();
+    const uint8_t* visible  = nullptr;
+    if (subCount > 1 && localBounds.IsValid())
+    {
+        m_cullBounds.Transform(mesh.GetSubMeshBounds(), model);
+        m_cullVisible.resize(m_cullBounds.Padded());
+        const uint32_t numVisible = m_frustum.TestAABBs(m_cullBounds, m_cullVisible.data());
+        m_lastCulled += subCount - numVisible;
+        if (numVisible == 0)
+            return;
+        visible = m_cullVisible.data();
+    }
+
     // Compute camera-space Z of the mesh origin for sorting.
     XMVECTOR origin = XMVector3Transform(XMVectorSet(0, 0, 0, 1), model);
     XMVECTOR viewOrigin = XMVector3Transform(origin, m_view);
@@ -358,19 +382,76 @@ void ForwardPipeline::SubmitMesh(const Mesh& mesh, DirectX::XMMATRIX model,
 
     uint32_t drawIdx = static_cast<uint32_t>(m_queuedDraws.size());
     m_queuedDraws.push_back({ &mesh, &mats });
+    const uint32_t xform = m_queue.PushTransform(model);
 
-    for (uint32_t i = 0; i < mesh.GetSubMeshCount(); ++i)
+    for (uint32_t i = 0; i < subCount; ++i)
     {
+        if (visible && !visible[i])
+            continue;
+        ++m_lastVisible;
         RenderItem item;
-        item.model        = model;
-        item.meshIndex    = drawIdx;
-        item.subMeshIndex = i;
-        item.sortDepth    = depth;
-        item.transparent  = transparent || (mats[i].alphaMode == AlphaMode::Transparent);
+        item.meshIndex      = drawIdx;
+        item.subMeshIndex   = i;
+        item.transformIndex = xform;
+        item.sortDepth      = depth;
+        item.transparent    = transparent || (mats[i].alphaMode == AlphaMode::Transparent);
+        SetSortState(item, mesh, mats[i]);
         m_queue.Push(item);
     }
 }
 
+void ForwardPipeline::SubmitVisible(const VisibilityIndex& index)
+{
+    using namespace DirectX;
+
+    m_visibleProxies.clear();
+    index.QueryFrustum(m_frustum, m_visibleProxies);
+    m_lastCulled += index.GetProxyCount() - static_cast<uint32_t>(m_visibleProxies.size());
+
+    index.ForEachObject(m_visibleProxies,
+        [&](const VisibilityIndex::Object& o, const uint32_t* subMeshes, uint32_t count)
+        {
+            if (!o.materials) return;
+            const XMMATRIX model = XMLoadFloat4x4(&o.world);
+
+            // Sorted by the object's origin, as SubmitMesh does.
+            XMVECTOR viewOrigin = XMVector3Transform(model.r[3], m_view);
+            float depth = XMVectorGetZ(viewOrigin);
+
+            const uint32_t drawIdx = static_cast<uint32_t>(m_queuedDraws.size());
+            m_queuedDraws.push_back({ o.mesh, o.materials });
+            const uint32_t xform = m_queue.PushTransform(model);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const SubMat& mat = (*o.materials)[subMeshes[i]];
+                RenderItem item;
+                item.meshIndex      = drawIdx;
+                item.subMeshIndex   = subMeshes[i];
+                item.transformIndex = xform;
+                item.sortDepth      = depth;
+                item.transparent    = mat.alphaMode == AlphaMode::Transparent;
+                SetSortState(item, *o.mesh, mat);
+                m_queue.Push(item);
+            }
+            m_lastVisible += count;
+        });
+}
+
+// Sort-key grouping: alpha mode picks blend/raster state, the albedo texture
+// stands in for the material's bindings, and the mesh for its buffers.
+static uint16_t KeyHash(const void* p)
+{
+    const uint64_t v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+    return static_cast<uint16_t>((v * 0x9E3779B97F4A7C15ull) >> 48);
+}
+
+void ForwardPipeline::SetSortState(RenderItem& item, const Mesh& mesh, const SubMat& mat)
+{
+    item.state    = static_cast<uint8_t>(mat.alphaMode);
+    item.material = KeyHash(mat.albedo.get());
+    item.mesh     = KeyHash(&mesh);
+}
+
 void ForwardPipeline::Flush(ID3D11DeviceContext* ctx)
 {
     using namespace DirectX;
@@ -378,82 +459,59 @@ void ForwardPipeline::Flush(ID3D11DeviceContext* ctx)
     m_queue.Sort();
     m_lastDrawCalls = 0;
 
-    AlphaMode prevMode = AlphaMode::Opaque;
+    // Anything may have been bound since the last Flush, so start from
+    // unknown; within the loop, neighbours that share state skip the calls.
+    m_binds.Reset();
+    m_binds.ResetStats();
+    m_binds.SetPSSampler(ctx, 0, m_sampler.GetSampler());
 
-    for (auto& item : m_queue.Items())
+    TransformCBData cb;
+    XMStoreFloat4x4(&cb.view,       m_view);
+    XMStoreFloat4x4(&cb.projection, m_proj);
+
+    const auto& items      = m_queue.Items();
+    const auto& transforms = m_queue.Transforms();
+    for (const uint32_t index : m_queue.Order())
     {
+        const RenderItem& item = items[index];
         auto& draw = m_queuedDraws[item.meshIndex];
 
-        TransformCBData cb;
-        XMStoreFloat4x4(&cb.model,      item.model);
-        XMStoreFloat4x4(&cb.view,       m_view);
-        XMStoreFloat4x4(&cb.projection, m_proj);
-        m_transformCB.Update(ctx, cb);
-        m_transformCB.BindVS(ctx, 0); m_transformCB.BindPS(ctx, 0);
+        cb.model = transforms[item.transformIndex];
+        m_binds.UpdateConstants(ctx, m_transformCB.GetBuffer(), &cb, static_cast<uint32_t>(sizeof(cb)));
+        m_binds.SetVSConstantBuffer(ctx, 0, m_transformCB.GetBuffer());
+        m_binds.SetPSConstantBuffer(ctx, 0, m_transformCB.GetBuffer());
 
         auto& mat = (*draw.mats)[item.subMeshIndex];
 
-        // Handle alpha mode state changes
-        if (mat.alphaMode != prevMode)
-        {
-            float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-            switch (mat.alphaMode)
-            {
-            case AlphaMode::Opaque:
-                ctx->OMSetBlendState(nullptr, blendFactor, 0xFFFFFFFF);
-                ctx->RSSetState(nullptr);
-                break;
-            case AlphaMode::Cutout:
-                ctx->OMSetBlendState(nullptr, blendFactor, 0xFFFFFFFF);
-                ctx->RSSetState(m_noCullRS.Get());
-                break;
-            case AlphaMode::Transparent:
-                ctx->OMSetBlendState(m_alphaBlend.Get(), blendFactor, 0xFFFFFFFF);
-                ctx->RSSetState(m_noCullRS.Get());
-                break;
-            }
-            prevMode = mat.alphaMode;
-        }
+        // Alpha mode picks blend and raster state
+        m_binds.SetBlendState(ctx, mat.alphaMode == AlphaMode::Transparent ? m_alphaBlend.Get() : nullptr);
+        m_binds.SetRasterizerState(ctx, mat.alphaMode == AlphaMode::Opaque ? nullptr : m_noCullRS.Get());
 
         // Set alpha cutoff in material CB when needed
-        if (mat.alphaMode == AlphaMode::Cutout)
+        if (mat.alphaMode != AlphaMode::Opaque)
         {
             MaterialParamsCBData mc = {};
             mc.albedoTint     = { 1.0f, 1.0f, 1.0f };
             mc.roughnessScale = 1.0f;
-            mc.alphaCutoff    = mat.alphaCutoff;
+            mc.alphaCutoff    = mat.alphaMode == AlphaMode::Cutout ? mat.alphaCutoff : 0.0f;
             mc.emissiveIntensity = 1.0f;
             mc.emissiveColor  = { 1.0f, 1.0f, 1.0f };
-            m_materialCB.Update(ctx, mc);
-            m_materialCB.BindPS(ctx, 3);
-        }
-        else if (mat.alphaMode != AlphaMode::Opaque)
-        {
-            MaterialParamsCBData mc = {};
-            mc.albedoTint     = { 1.0f, 1.0f, 1.0f };
-            mc.roughnessScale = 1.0f;
-            mc.emissiveIntensity = 1.0f;
-            mc.emissiveColor  = { 1.0f, 1.0f, 1.0f };
-            m_materialCB.Update(ctx, mc);
-            m_materialCB.BindPS(ctx, 3);
+            m_binds.UpdateConstants(ctx, m_materialCB.GetBuffer(), &mc, static_cast<uint32_t>(sizeof(mc)));
+            m_binds.SetPSConstantBuffer(ctx, 3, m_materialCB.GetBuffer());
         }
 
-        mat.albedo->BindPS(ctx, 0);
-        mat.roughness->BindPS(ctx, 1);
-        mat.normal->BindPS(ctx, 2);
-        (mat.metallic ? mat.metallic : m_defaultBlack)->BindPS(ctx, 7);
-        (mat.emissive ? mat.emissive : m_defaultBlack)->BindPS(ctx, 9);
+        m_binds.SetPSShaderResource(ctx, 0, mat.albedo->GetSRV());
+        m_binds.SetPSShaderResource(ctx, 1, mat.roughness->GetSRV());
+        m_binds.SetPSShaderResource(ctx, 2, mat.normal->GetSRV());
+        m_binds.SetPSShaderResource(ctx, 7, (mat.metallic ? mat.metallic : m_defaultBlack)->GetSRV());
+        m_binds.SetPSShaderResource(ctx, 9, (mat.emissive ? mat.emissive : m_defaultBlack)->GetSRV());
         draw.mesh->DrawSubMesh(ctx, item.subMeshIndex);
         ++m_lastDrawCalls;
     }
 
     // Restore default state
-    if (prevMode != AlphaMode::Opaque)
-    {
-        float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-        ctx->OMSetBlendState(nullptr, blendFactor, 0xFFFFFFFF);
-        ctx->RSSetState(nullptr);
-    }
+    m_binds.SetBlendState(ctx, nullptr);
+    m_binds.SetRasterizerState(ctx, nullptr);
 }
 
 void ForwardPipeline::SetMaterialParams(ID3D11DeviceContext* ctx,
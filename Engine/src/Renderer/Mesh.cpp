@@ -9,7 +9,7 @@
 
 namespace SE {
 
-bool Mesh::Load(ID3D11Device* device, const char* path)
+bool Mesh::Load(ID3D11Device* device, const char* path, bool keepCPUGeometry)
 {
     Assimp::Importer importer;
 
@@ -36,13 +36,18 @@ bool Mesh::Load(ID3D11Device* device, const char* path)
 
     m_subMeshes.reserve(scene->mNumMeshes);
     m_bounds = AABB{}; // reset to invalid
+    m_subMeshBounds.Resize(scene->mNumMeshes);
+    m_cpuPositions.clear();
+    m_cpuIndices.clear();
 
     for (uint32_t m = 0; m < scene->mNumMeshes; ++m)
     {
         const aiMesh* mesh = scene->mMeshes[m];
+        const uint32_t baseVertex = static_cast<uint32_t>(m_cpuPositions.size());
 
         std::vector<MeshVertex> verts;
         verts.reserve(mesh->mNumVertices);
+        AABB subBounds;
 
         for (uint32_t v = 0; v < mesh->mNumVertices; ++v)
         {
@@ -66,9 +71,19 @@ bool Mesh::Load(ID3D11Device* device, const char* path)
             vtx.by = mesh->mBitangents ? mesh->mBitangents[v].y : 1.0f;
             vtx.bz = mesh->mBitangents ? mesh->mBitangents[v].z : 0.0f;
             verts.push_back(vtx);
-            m_bounds.Expand({ vtx.x, vtx.y, vtx.z });
+            subBounds.Expand({ vtx.x, vtx.y, vtx.z });
+            if (keepCPUGeometry) m_cpuPositions.push_back({ vtx.x, vtx.y, vtx.z });
         }
 
+        if (subBounds.IsValid())
+        {
+            m_bounds.Expand(subBounds.min);
+            m_bounds.Expand(subBounds.max);
+        }
+        else
+            subBounds = AABB{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+        m_subMeshBounds.Set(m, subBounds);
+
         std::vector<uint32_t> indices;
         indices.reserve(mesh->mNumFaces * 3);
         for (uint32_t f = 0; f < mesh->mNumFaces; ++f)
@@ -77,6 +92,9 @@ bool Mesh::Load(ID3D11Device* device, const char* path)
             for (uint32_t i = 0; i < face.mNumIndices; ++i)
                 indices.push_back(face.mIndices[i]);
         }
+        if (keepCPUGeometry)
+            for (uint32_t idx : indices)
+                m_cpuIndices.push_back(baseVertex + idx);
 
         SubMesh sm;
         if (!sm.vb.Create(device, verts.data(),
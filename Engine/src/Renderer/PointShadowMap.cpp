@@ -161,12 +161,51 @@ void PointShadowMap::BeginFace(ID3D11DeviceContext* ctx, int face,
     // Cache per-face data used by DrawMesh
     m_lightPos     = lightPos;
     m_lightFar     = lightFar;
+    m_face         = face;
     XMMATRIX view  = FaceView(lightPos, face);
     XMMATRIX proj  = XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 0.05f, lightFar);
     m_faceViewProj = view * proj;
+    m_faceFrustum.ExtractFromVP(m_faceViewProj);
 }
 
 void PointShadowMap::DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATRIX model)
+{
+    BindModel(ctx, model);
+    for (uint32_t i = 0; i < mesh.GetSubMeshCount(); ++i)
+        mesh.DrawSubMesh(ctx, i);
+}
+
+void PointShadowMap::DrawSubMeshes(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATRIX model,
+                                   const uint32_t* subMeshes, uint32_t count)
+{
+    BindModel(ctx, model);
+    for (uint32_t i = 0; i < count; ++i)
+        mesh.DrawSubMesh(ctx, subMeshes[i]);
+}
+
+void PointShadowMap::DrawCasters(ID3D11DeviceContext* ctx, const VisibilityIndex& index)
+{
+    // The face pyramid reaches past the light's range towards its corners.
+    const float radiusSq = m_lightFar * m_lightFar;
+    m_casters.clear();
+    index.Query([&](const AABB& b)
+    {
+        const Containment f = m_faceFrustum.Classify(b);
+        if (f == Containment::Outside) return f;
+        const Containment r = VisibilityIndex::ClassifySphere(b, m_lightPos, radiusSq);
+        if (r == Containment::Outside) return r;
+        return f == Containment::Inside && r == Containment::Inside ? Containment::Inside
+                                                                    : Containment::Partial;
+    }, m_casters);
+
+    m_faceStats[m_face] = index.ForEachCaster(m_casters,
+        [&](const VisibilityIndex::Object& o, const uint32_t* subMeshes, uint32_t count)
+        {
+            DrawSubMeshes(ctx, *o.mesh, XMLoadFloat4x4(&o.world), subMeshes, count);
+        });
+}
+
+void PointShadowMap::BindModel(ID3D11DeviceContext* ctx, XMMATRIX model)
 {
     CBData cb;
     XMStoreFloat4x4(&cb.worldViewProj, model * m_faceViewProj);
@@ -176,9 +215,6 @@ void PointShadowMap::DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATR
     m_cb.Update(ctx, cb);
     m_cb.BindVS(ctx, 0);
     m_cb.BindPS(ctx, 0);
-
-    for (uint32_t i = 0; i < mesh.GetSubMeshCount(); ++i)
-        mesh.DrawSubMesh(ctx, i);
 }
 
 void PointShadowMap::EndFace(ID3D11DeviceContext* ctx)
@@ -0,0 +1,78 @@
+#include "Engine/Renderer/RenderQueue.h"
+#include <cstring>
+#include <utility>
+
+namespace SE {
+
+uint64_t RenderQueue::MakeKey(const RenderItem& item)
+{
+    // Non-negative floats order like their bit patterns (31 bits, the sign
+    // being 0). Opaques keep the top 24 of those 31, a depth quantised relative to its
+    // magnitude; transparents keep all of it so blending order is exact.
+    // Behind the camera (and NaN) clamps to 0.
+    const float depth = item.sortDepth > 0.0f ? item.sortDepth : 0.0f;
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    const uint64_t pass     = item.pass  & 3u;
+    const uint64_t state    = item.state & 3u;
+    const uint64_t material = item.material;
+    const uint64_t mesh     = item.mesh;
+
+    if (!item.transparent)
+        return pass << 62 | state << 59 | material << 43 | mesh << 27 | static_cast<uint64_t>(bits >> 7) << 3;
+    return pass << 62 | 1ull << 61 | static_cast<uint64_t>(0x7FFFFFFFu - bits) << 30
+         | state << 28 | material << 12 | (mesh & 0xFFFu);
+}
+
+// LSD radix sort of (key, index) pairs, one byte per pass. All eight
+// histograms come from one read of the keys, and a pass whose byte is the
+// same in every key (e.g. unused pass bits) is skipped.
+void RenderQueue::Sort()
+{
+    const uint32_t n = static_cast<uint32_t>(m_keys.size());
+    m_order.resize(n);
+    for (uint32_t i = 0; i < n; ++i)
+        m_order[i] = i;
+    if (n < 2) return;
+
+    uint32_t counts[8][256] = {};
+    for (const uint64_t key : m_keys)
+        for (int d = 0; d < 8; ++d)
+            ++counts[d][(key >> (d * 8)) & 0xFF];
+
+    m_keyScratch[0].assign(m_keys.begin(), m_keys.end());
+    m_keyScratch[1].resize(n);
+    m_orderScratch.resize(n);
+    uint64_t* keysIn  = m_keyScratch[0].data();
+    uint64_t* keysOut = m_keyScratch[1].data();
+    uint32_t* idxIn   = m_order.data();
+    uint32_t* idxOut  = m_orderScratch.data();
+
+    for (int d = 0; d < 8; ++d)
+    {
+        const int shift = d * 8;
+        uint32_t* c     = counts[d];
+        if (c[(keysIn[0] >> shift) & 0xFF] == n) continue;
+
+        uint32_t sum = 0;
+        for (int b = 0; b < 256; ++b)
+        {
+            const uint32_t count = c[b];
+            c[b] = sum;
+            sum += count;
+        }
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const uint32_t pos = c[(keysIn[i] >> shift) & 0xFF]++;
+            keysOut[pos] = keysIn[i];
+            idxOut[pos]  = idxIn[i];
+        }
+        std::swap(keysIn, keysOut);
+        std::swap(idxIn, idxOut);
+    }
+
+    if (idxIn != m_order.data())
+        std::memcpy(m_order.data(), idxIn, n * sizeof(uint32_t));
+}
+
+} // namespace SE
@@ -10,33 +10,40 @@ void ShaderLibrary::Init(ID3D11Device* device)
     m_device = device;
 }
 
-std::string ShaderLibrary::MakeKey(const std::wstring& file,
-                                    const std::vector<ShaderDefine>& defines) const
+const std::string& ShaderLibrary::MakeKey(const std::wstring& file,
+                                           const std::vector<ShaderDefine>& defines,
+                                           const char* entryPoint)
 {
     // Narrow file path via WideCharToMultiByte + sorted defines → unique cache key.
     int len = WideCharToMultiByte(CP_UTF8, 0, file.c_str(), (int)file.size(), nullptr, 0, nullptr, nullptr);
-    std::string key(len, '\0');
-    WideCharToMultiByte(CP_UTF8, 0, file.c_str(), (int)file.size(), key.data(), len, nullptr, nullptr);
-    key += '|';
-    // Sort defines by name so order doesn't affect the key.
-    auto sorted = defines;
-    std::sort(sorted.begin(), sorted.end(),
-        [](const ShaderDefine& a, const ShaderDefine& b) { return a.name < b.name; });
-    for (auto& d : sorted)
+    m_key.resize(static_cast<size_t>(len));
+    WideCharToMultiByte(CP_UTF8, 0, file.c_str(), (int)file.size(), m_key.data(), len, nullptr, nullptr);
+    m_key += '|';
+    // Sort defines by name so order doesn't affect the key; pointers, not copies.
+    m_sortedDefines.clear();
+    for (auto& d : defines)
+        m_sortedDefines.push_back(&d);
+    std::sort(m_sortedDefines.begin(), m_sortedDefines.end(),
+        [](const ShaderDefine* a, const ShaderDefine* b) { return a->name < b->name; });
+    for (const ShaderDefine* d : m_sortedDefines)
+    {
+        m_key += d->name;
+        m_key += '=';
+        m_key += d->value;
+        m_key += ';';
+    }
+    if (entryPoint)
     {
-        key += d.name;
-        key += '=';
-        key += d.value;
-        key += ';';
+        m_key += '@';
+        m_key += entryPoint;
     }
-    return key;
+    return m_key;
 }
 
 const ShaderPermutation* ShaderLibrary::Get(const std::wstring& hlslFile,
                                              const std::vector<ShaderDefine>& defines)
 {
-    std::string key = MakeKey(hlslFile, defines);
-    auto it = m_cache.find(key);
+    auto it = m_cache.find(MakeKey(hlslFile, defines));
     if (it != m_cache.end())
         return &it->second;
 
@@ -83,7 +90,7 @@ const ShaderPermutation* ShaderLibrary::Get(const std::wstring& hlslFile,
     SE_HR(m_device->CreatePixelShader(
         psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &perm.ps));
 
-    auto [insertIt, _] = m_cache.emplace(std::move(key), std::move(perm));
+    auto [insertIt, _] = m_cache.emplace(m_key, std::move(perm));
     return &insertIt->second;
 }
 
@@ -97,9 +104,7 @@ ID3D11ComputeShader* ShaderLibrary::GetCS(const std::wstring& hlslFile,
                                            const char* entryPoint,
                                            const std::vector<ShaderDefine>& defines)
 {
-    // Build key with entry point appended
-    std::string key = MakeKey(hlslFile, defines) + "@" + entryPoint;
-    auto it = m_csCache.find(key);
+    auto it = m_csCache.find(MakeKey(hlslFile, defines, entryPoint));
     if (it != m_csCache.end())
         return it->second.Get();
 
@@ -133,7 +138,7 @@ ID3D11ComputeShader* ShaderLibrary::GetCS(const std::wstring& hlslFile,
         return nullptr;
     }
 
-    auto [insertIt, _] = m_csCache.emplace(std::move(key), std::move(cs));
+    auto [insertIt, _] = m_csCache.emplace(m_key, std::move(cs));
     return insertIt->second.Get();
 }
 
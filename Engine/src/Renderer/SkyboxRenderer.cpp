@@ -70,6 +70,15 @@ bool SkyboxRenderer::Init(ID3D11Device* device, RenderStateCache& cache, ShaderL
 }
 
 bool SkyboxRenderer::LoadPanorama(ID3D11Device* device, const wchar_t* path)
+{
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+    if (!LoadPanoramaSRV(device, path, srv)) return false;
+    m_panoramaSRV = std::move(srv);
+    return true;
+}
+
+bool SkyboxRenderer::LoadPanoramaSRV(ID3D11Device* device, const wchar_t* path,
+                                     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& out)
 {
     DirectX::ScratchImage image;
     HRESULT hr = DirectX::LoadFromDDSFile(path, DirectX::DDS_FLAGS_NONE, nullptr, image);
@@ -118,7 +127,7 @@ bool SkyboxRenderer::LoadPanorama(ID3D11Device* device, const wchar_t* path)
         mipped.GetImages(), mipped.GetImageCount(), mippedMeta,
         D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0,
         DirectX::CREATETEX_DEFAULT,
-        m_panoramaSRV.ReleaseAndGetAddressOf());
+        out.ReleaseAndGetAddressOf());
     if (FAILED(hr))
     {
         SE_LOG_ERROR("SkyboxRenderer: CreateShaderResourceView failed: 0x%08X", hr);
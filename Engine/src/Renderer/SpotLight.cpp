@@ -123,14 +123,39 @@ void SpotLight::BeginShadowPass(ID3D11DeviceContext* ctx)
 }
 
 void SpotLight::DrawMesh(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATRIX model)
+{
+    BindShadowModel(ctx, model);
+    mesh.Draw(ctx);
+}
+
+void SpotLight::DrawSubMeshes(ID3D11DeviceContext* ctx, const Mesh& mesh, XMMATRIX model,
+                              const uint32_t* subMeshes, uint32_t count)
+{
+    BindShadowModel(ctx, model);
+    for (uint32_t i = 0; i < count; ++i)
+        mesh.DrawSubMesh(ctx, subMeshes[i]);
+}
+
+void SpotLight::DrawCasters(ID3D11DeviceContext* ctx, const VisibilityIndex& index)
+{
+    XMFLOAT3 dir;
+    XMStoreFloat3(&dir, XMVector3Normalize(XMLoadFloat3(&direction)));
+    m_casters.clear();
+    index.QueryCone(position, dir, range, XMConvertToRadians(outerAngle), m_casters);
+    m_casterStats = index.ForEachCaster(m_casters,
+        [&](const VisibilityIndex::Object& o, const uint32_t* subMeshes, uint32_t count)
+        {
+            DrawSubMeshes(ctx, *o.mesh, XMLoadFloat4x4(&o.world), subMeshes, count);
+        });
+}
+
+void SpotLight::BindShadowModel(ID3D11DeviceContext* ctx, XMMATRIX model)
 {
     ShadowCBData cb;
     XMStoreFloat4x4(&cb.model, model);
     XMStoreFloat4x4(&cb.viewProj, m_viewProj);
     m_shadowCB.Update(ctx, cb);
     m_shadowCB.BindVS(ctx, 0);
-
-    mesh.Draw(ctx);
 }
 
 void SpotLight::EndShadowPass(ID3D11DeviceContext* ctx)
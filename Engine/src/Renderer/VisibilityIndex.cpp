@@ -0,0 +1,187 @@
+#include "Engine/Renderer/VisibilityIndex.h"
+#include <cmath>
+#include <cstring>
+
+namespace SE {
+
+using namespace DirectX;
+
+static AABB BoxAt(const AABBSoA& s, uint32_t i)
+{
+    return { { s.cx[i] - s.ex[i], s.cy[i] - s.ey[i], s.cz[i] - s.ez[i] },
+             { s.cx[i] + s.ex[i], s.cy[i] + s.ey[i], s.cz[i] + s.ez[i] } };
+}
+
+Containment VisibilityIndex::ClassifySphere(const AABB& b, const XMFLOAT3& c, float radiusSq)
+{
+    const float dx = c.x < b.min.x ? b.min.x - c.x : c.x > b.max.x ? c.x - b.max.x : 0.0f;
+    const float dy = c.y < b.min.y ? b.min.y - c.y : c.y > b.max.y ? c.y - b.max.y : 0.0f;
+    const float dz = c.z < b.min.z ? b.min.z - c.z : c.z > b.max.z ? c.z - b.max.z : 0.0f;
+    if (dx * dx + dy * dy + dz * dz > radiusSq)
+        return Containment::Outside;
+
+    // Inside when the farthest corner is.
+    const float fx = fmaxf(fabsf(c.x - b.min.x), fabsf(c.x - b.max.x));
+    const float fy = fmaxf(fabsf(c.y - b.min.y), fabsf(c.y - b.max.y));
+    const float fz = fmaxf(fabsf(c.z - b.min.z), fabsf(c.z - b.max.z));
+    return fx * fx + fy * fy + fz * fz <= radiusSq ? Containment::Inside : Containment::Partial;
+}
+
+uint32_t VisibilityIndex::AddObject(const Mesh& mesh, const std::vector<ForwardPipeline::SubMat>* materials,
+                                    FXMMATRIX world, bool castShadow)
+{
+    uint32_t id = m_freeObjects;
+    if (id == k_Invalid)
+    {
+        id = static_cast<uint32_t>(m_objects.size());
+        m_objects.emplace_back();
+    }
+    else
+    {
+        m_freeObjects = m_objects[id].firstProxy;
+    }
+
+    const uint32_t count = mesh.GetSubMeshCount();
+    Object&        o     = m_objects[id];
+    o.mesh       = &mesh;
+    o.materials  = materials;
+    o.firstProxy = AllocateProxies(count);
+    o.castShadow = castShadow;
+    XMStoreFloat4x4(&o.world, world);
+
+    m_scratch.Transform(mesh.GetSubMeshBounds(), world);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t proxy = o.firstProxy + i;
+        const AABB     b     = BoxAt(m_scratch, i);
+        m_proxies[proxy] = { id, i, m_tree.CreateProxy(b, proxy), b };
+    }
+    if (castShadow) m_casterCount += count;
+    return id;
+}
+
+// Best fit among the freed runs, the remainder staying free; otherwise the
+// run is appended. Meshes are usually re-added with the same submesh count,
+// so most reuse is an exact fit.
+uint32_t VisibilityIndex::AllocateProxies(uint32_t count)
+{
+    if (count == 0) return 0;
+
+    size_t best = m_freeRuns.size();
+    for (size_t r = 0; r < m_freeRuns.size(); ++r)
+    {
+        if (m_freeRuns[r].count < count) continue;
+        if (best == m_freeRuns.size() || m_freeRuns[r].count < m_freeRuns[best].count)
+            best = r;
+        if (m_freeRuns[r].count == count) break;
+    }
+    if (best == m_freeRuns.size())
+    {
+        const uint32_t first = static_cast<uint32_t>(m_proxies.size());
+        m_proxies.resize(m_proxies.size() + count);
+        return first;
+    }
+
+    ProxyRun& run = m_freeRuns[best];
+    const uint32_t first = run.first;
+    run.first += count;
+    run.count -= count;
+    if (run.count == 0)
+    {
+        run = m_freeRuns.back();
+        m_freeRuns.pop_back();
+    }
+    return first;
+}
+
+void VisibilityIndex::SetTransform(uint32_t object, FXMMATRIX world)
+{
+    Object& o = m_objects[object];
+    if (!o.mesh) return;
+
+    XMFLOAT4X4 w;
+    XMStoreFloat4x4(&w, world);
+    if (std::memcmp(&w, &o.world, sizeof(w)) == 0) return;
+    o.world = w;
+
+    m_scratch.Transform(o.mesh->GetSubMeshBounds(), world);
+    for (uint32_t i = 0; i < o.mesh->GetSubMeshCount(); ++i)
+    {
+        Proxy& p = m_proxies[o.firstProxy + i];
+        const XMFLOAT3 from = p.bounds.Center();
+        p.bounds = BoxAt(m_scratch, i);
+        const XMFLOAT3 to = p.bounds.Center();
+        m_tree.MoveProxy(p.treeId, p.bounds, { to.x - from.x, to.y - from.y, to.z - from.z });
+    }
+}
+
+void VisibilityIndex::RemoveObject(uint32_t object)
+{
+    Object& o = m_objects[object];
+    if (!o.mesh) return;
+    const uint32_t count = o.mesh->GetSubMeshCount();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Proxy& p = m_proxies[o.firstProxy + i];
+        m_tree.DestroyProxy(p.treeId);
+        p.object = k_Invalid;
+        p.treeId = k_Invalid;
+    }
+    if (count > 0) m_freeRuns.push_back({ o.firstProxy, count });
+    if (o.castShadow) m_casterCount -= count;
+
+    o.mesh        = nullptr;
+    o.materials   = nullptr;
+    o.firstProxy  = m_freeObjects;
+    m_freeObjects = object;
+}
+
+void VisibilityIndex::Clear()
+{
+    m_tree.Clear();
+    m_objects.clear();
+    m_proxies.clear();
+    m_freeObjects = k_Invalid;
+    m_freeRuns.clear();
+    m_casterCount = 0;
+}
+
+void VisibilityIndex::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out) const
+{
+    Query([&frustum](const AABB& b) { return frustum.Classify(b); }, out);
+}
+
+void VisibilityIndex::QuerySphere(XMFLOAT3 center, float radius, std::vector<uint32_t>& out) const
+{
+    const float radiusSq = radius * radius;
+    Query([&](const AABB& b) { return ClassifySphere(b, center, radiusSq); }, out);
+}
+
+void VisibilityIndex::QueryCone(XMFLOAT3 apex, XMFLOAT3 dir, float range, float halfAngle,
+                                std::vector<uint32_t>& out) const
+{
+    const float rangeSq = range * range;
+    const float cosA    = cosf(halfAngle);
+    const float sinA    = sinf(halfAngle);
+
+    // Range sphere first, then the cone against the box's bounding sphere:
+    // outside when that sphere is behind the apex or farther from the cone's
+    // surface than its radius. Never Inside — the sphere test can't tell.
+    Query([&](const AABB& b)
+    {
+        if (ClassifySphere(b, apex, rangeSq) == Containment::Outside)
+            return Containment::Outside;
+
+        const XMFLOAT3 c = b.Center(), e = b.Extents();
+        const float r     = sqrtf(e.x * e.x + e.y * e.y + e.z * e.z);
+        const float vx    = c.x - apex.x, vy = c.y - apex.y, vz = c.z - apex.z;
+        const float along = vx * dir.x + vy * dir.y + vz * dir.z;
+        const float lenSq = vx * vx + vy * vy + vz * vz;
+        const float perp  = sqrtf(fmaxf(lenSq - along * along, 0.0f));
+        if (along < -r || cosA * perp - sinA * along > r)
+            return Containment::Outside;
+        return Containment::Partial;
+    }, out);
+}
+
+} // namespace SE
@@ -0,0 +1,34 @@
+#include "Engine/Scene/ComponentPool.h"
+#include <atomic>
+
+namespace SE {
+
+uint32_t NextComponentTypeID()
+{
+    static std::atomic<uint32_t> next{ 0 };
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ComponentRegistry::RemoveAll(EntityID id)
+{
+    for (auto& pool : m_pools)
+        if (pool) pool->Remove(id);
+}
+
+void ComponentRegistry::UpdateAll(float dt)
+{
+    for (auto& pool : m_pools)
+        if (pool && pool->IsUpdateEnabled()) pool->UpdateAll(dt);
+}
+
+void ComponentRegistry::UpdateEntity(EntityID id, float dt)
+{
+    for (auto& pool : m_pools)
+    {
+        if (!pool || !pool->IsUpdateEnabled()) continue;
+        Component* c = pool->GetBase(id);
+        if (c && c->enabled) c->Update(dt);
+    }
+}
+
+} // namespace SE
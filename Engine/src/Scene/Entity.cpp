@@ -2,16 +2,14 @@
 
 namespace SE {
 
-Entity::Entity(EntityID id, std::string name)
-    : m_id(id), m_name(std::move(name))
+Entity::Entity(EntityID id, std::string name, ComponentRegistry* registry)
+    : m_id(id), m_name(std::move(name)), m_registry(registry)
 {
 }
 
 void Entity::Update(float dt)
 {
-    for (auto& [type, comp] : m_components)
-        if (comp->enabled)
-            comp->Update(dt);
+    m_registry->UpdateEntity(m_id, dt);
 }
 
 } // namespace SE
@@ -3,41 +3,254 @@
 
 namespace SE {
 
+// Makes room for extra more elements; growth stays geometric across calls.
+template<typename V>
+static void ReserveMore(V& v, size_t extra)
+{
+    const size_t need = v.size() + extra;
+    if (need > v.capacity()) v.reserve(std::max(need, v.capacity() * 2));
+}
+
+Scene::Scene()
+    : m_slots(1), m_registry(std::make_unique<ComponentRegistry>())
+{
+}
+
 Entity* Scene::CreateEntity(const std::string& name)
 {
-    auto    e   = std::make_unique<Entity>(m_nextID++, name);
-    Entity* ptr = e.get();
-    m_entities.push_back(std::move(e));
-    return ptr;
+    Entity* e = NewEntity(name);
+    LinkName(e->GetID());
+    return e;
+}
+
+EntityID Scene::ReserveEntities(uint32_t count, uint32_t names)
+{
+    // Free slots are reused first, so no new ID goes past this.
+    const size_t   fresh = count > m_freeSlots.size() ? count - m_freeSlots.size() : 0;
+    const EntityID maxID = static_cast<EntityID>(m_slots.size() + fresh);
+    ReserveMore(m_slots, fresh);
+    ReserveMore(m_live, count);
+    m_entityPool.Reserve(count);
+    // Rehashing a grown index walks every node; do it once up front.
+    if (names > 0) m_names.reserve(m_names.size() + names);
+    return maxID;
+}
+
+void Scene::Reserve(const PrefabCount* prefabs, uint32_t prefabCount, uint32_t extraEntities)
+{
+    uint32_t total = extraEntities;
+    for (uint32_t i = 0; i < prefabCount; ++i) total += prefabs[i].count;
+    if (total == 0) return;
+
+    const EntityID maxID = ReserveEntities(total, prefabCount + extraEntities);
+    m_registry->Pool<TransformComponent>().Reserve(total, maxID);
+
+    // Pools shared between prefabs grow by the sum, through the first part
+    // of that type.
+    std::vector<std::pair<const Prefab::PartBase*, uint32_t>> byType;
+    for (uint32_t i = 0; i < prefabCount; ++i)
+    {
+        for (const auto& part : prefabs[i].prefab->m_parts)
+        {
+            const uint32_t type = part->GetTypeID();
+            if (type >= byType.size()) byType.resize(type + 1, { nullptr, 0u });
+            if (!byType[type].first) byType[type].first = part.get();
+            byType[type].second += prefabs[i].count;
+        }
+    }
+    for (const auto& [part, count] : byType)
+        if (part) part->Reserve(*m_registry, count, maxID);
+}
+
+void Scene::Instantiate(const Prefab& prefab, const InstanceTransform* transforms, uint32_t count)
+{
+    if (count == 0) return;
+
+    // A no-op when the level reserved for these already.
+    const PrefabCount instances = { &prefab, count };
+    Reserve(&instances, 1);
+
+    // One pass, each instance finished before the next: the name is looked
+    // up once and the rest join its chain directly.
+    NameChain* chain = nullptr;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Entity* e = NewEntity(prefab.GetName());
+        if (chain) AppendName(e->GetID(), *chain);
+        else
+        {
+            LinkName(e->GetID());
+            chain = &m_names.find(prefab.GetName())->second;
+        }
+
+        TransformComponent* t = e->AddComponent<TransformComponent>();
+        t->position = transforms[i].position;
+        t->eulerDeg = transforms[i].eulerDeg;
+        t->scale    = transforms[i].scale;
+        for (const auto& part : prefab.m_parts)
+            part->AddTo(*e);
+    }
+}
+
+Entity* Scene::NewEntity(const std::string& name)
+{
+    EntityID id;
+    if (!m_freeSlots.empty())
+    {
+        id = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        id = static_cast<EntityID>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot& slot  = m_slots[id];
+    slot.entity = m_entityPool.Create(id, name, m_registry.get());
+    slot.entity->m_generation = slot.generation;
+    slot.alive     = true;
+    slot.liveIndex = static_cast<uint32_t>(m_live.size());
+    m_live.push_back(slot.entity);
+    return slot.entity;
 }
 
 void Scene::DestroyEntity(EntityID id)
 {
-    m_entities.erase(
-        std::remove_if(m_entities.begin(), m_entities.end(),
-            [id](const auto& e) { return e->GetID() == id; }),
-        m_entities.end());
+    Entity* e = FindEntity(id);
+    if (!e || e->m_pendingDestroy) return;
+    e->m_pendingDestroy = true;
+    m_pendingDestroy.push_back(id);
+}
+
+void Scene::DestroyEntity(EntityHandle handle)
+{
+    if (Resolve(handle)) DestroyEntity(handle.id);
+}
+
+void Scene::FlushDestroyed()
+{
+    for (EntityID id : m_pendingDestroy)
+    {
+        Slot& slot = m_slots[id];
+        m_registry->RemoveAll(id);
+        UnlinkName(id);
+
+        Entity* last = m_live.back();
+        m_live[slot.liveIndex]           = last;
+        m_slots[last->GetID()].liveIndex = slot.liveIndex;
+        m_live.pop_back();
+
+        m_entityPool.Destroy(slot.entity);
+        slot.entity = nullptr;
+        ++slot.generation;
+        slot.alive = false;
+        m_freeSlots.push_back(id);
+    }
+    m_pendingDestroy.clear();
 }
 
 Entity* Scene::FindEntity(EntityID id) const
 {
-    for (const auto& e : m_entities)
-        if (e->GetID() == id) return e.get();
-    return nullptr;
+    if (id >= m_slots.size() || !m_slots[id].alive) return nullptr;
+    return m_slots[id].entity;
 }
 
 Entity* Scene::FindEntity(const std::string& name) const
 {
-    for (const auto& e : m_entities)
-        if (e->GetName() == name) return e.get();
-    return nullptr;
+    auto it = m_names.find(name);
+    return it != m_names.end() ? m_slots[it->second.head].entity : nullptr;
+}
+
+Entity* Scene::Resolve(EntityHandle handle) const
+{
+    Entity* e = FindEntity(handle.id);
+    return e && e->m_generation == handle.generation ? e : nullptr;
 }
 
 void Scene::Update(float dt)
 {
-    for (auto& e : m_entities)
-        if (e->active)
-            e->Update(dt);
+    m_registry->UpdateAll(dt);
+    m_scheduler.Run(dt);
+    FlushDestroyed();
+}
+
+void Scene::UpdateTransforms()
+{
+    ComponentPool<TransformComponent>* pool = m_registry->FindPool<TransformComponent>();
+    if (!pool) return;
+
+    if (pool->GetVersion() != m_transformPoolVersion ||
+        m_registry->GetHierarchyVersion() != m_transformHierarchyVersion)
+        RebuildTransformOrder();
+
+    for (const TransformComponent* t : m_transformOrder)
+        t->GetWorld();
+}
+
+void Scene::RebuildTransformOrder()
+{
+    ComponentPool<TransformComponent>& pool = m_registry->Pool<TransformComponent>();
+
+    m_transformOrder.clear();
+    pool.ForEach([this](EntityID, TransformComponent& t)
+    {
+        if (!t.parent) m_transformOrder.push_back(&t);
+    });
+    for (size_t i = 0; i < m_transformOrder.size(); ++i)
+        for (TransformComponent* child : m_transformOrder[i]->children)
+            m_transformOrder.push_back(child);
+
+    m_transformPoolVersion      = pool.GetVersion();
+    m_transformHierarchyVersion = m_registry->GetHierarchyVersion();
+}
+
+void Scene::LinkName(EntityID id)
+{
+    Slot& slot    = m_slots[id];
+    slot.nameNext = k_NoEntity;
+
+    const std::string& name = slot.entity->GetName();
+    auto it = m_names.find(name);
+    if (it == m_names.end())
+    {
+        slot.namePrev = k_NoEntity;
+        if (m_spareNames.empty())
+        {
+            m_names.emplace(name, NameChain{ id, id });
+            return;
+        }
+        // Reuse a node (and its key's buffer) from a name that went away.
+        auto node = std::move(m_spareNames.back());
+        m_spareNames.pop_back();
+        node.key()    = name;
+        node.mapped() = NameChain{ id, id };
+        m_names.insert(std::move(node));
+        return;
+    }
+    AppendName(id, it->second);
+}
+
+void Scene::AppendName(EntityID id, NameChain& chain)
+{
+    Slot& slot    = m_slots[id];
+    slot.namePrev = chain.tail;
+    slot.nameNext = k_NoEntity;
+    m_slots[chain.tail].nameNext = id;
+    chain.tail = id;
+}
+
+void Scene::UnlinkName(EntityID id)
+{
+    Slot& slot = m_slots[id];
+    auto  it   = m_names.find(slot.entity->GetName());
+
+    if (slot.namePrev != k_NoEntity) m_slots[slot.namePrev].nameNext = slot.nameNext;
+    else                             it->second.head                 = slot.nameNext;
+    if (slot.nameNext != k_NoEntity) m_slots[slot.nameNext].namePrev = slot.namePrev;
+    else                             it->second.tail                 = slot.namePrev;
+
+    if (it->second.head == k_NoEntity) m_spareNames.push_back(m_names.extract(it));
 }
 
 } // namespace SE
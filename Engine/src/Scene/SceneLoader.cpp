@@ -3,6 +3,10 @@
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 namespace SE {
 
@@ -21,7 +25,59 @@ static std::array<float, 4> ReadFloat4(const json& j, const std::string& key, st
     return { j[key][0].get<float>(), j[key][1].get<float>(), j[key][2].get<float>(), j[key][3].get<float>() };
 }
 
-bool SceneLoader::LoadFromFile(const std::string& path, SceneDescriptor& out)
+// Placement instance: { "position", "rotation", "scale" }, or the compact
+// form [px, py, pz, pitch, yaw, roll, scale] with trailing values optional.
+static SceneDescriptor::InstanceDesc ReadInstance(const json& j)
+{
+    SceneDescriptor::InstanceDesc inst;
+    if (j.is_array())
+    {
+        float v[7] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+        for (size_t i = 0; i < j.size() && i < 7; ++i) v[i] = j[i].get<float>();
+        inst.position = { v[0], v[1], v[2] };
+        inst.rotation = { v[3], v[4], v[5] };
+        inst.scale    = v[6];
+        return inst;
+    }
+    inst.position = ReadFloat3(j, "position", inst.position);
+    inst.rotation = ReadFloat3(j, "rotation", inst.rotation);
+    if (j.contains("scale")) inst.scale = j["scale"].get<float>();
+    return inst;
+}
+
+// "scatter": { "count", "min", "max", "scale": [lo, hi], "seed" }. Uses its
+// own generator so a seed gives the same layout on every platform.
+static void ExpandScatter(const json& j, std::vector<SceneDescriptor::InstanceDesc>& out)
+{
+    const int count = j.contains("count") ? j["count"].get<int>() : 0;
+    const std::array<float, 3> mn = ReadFloat3(j, "min", { -10.f, 0.f, -10.f });
+    const std::array<float, 3> mx = ReadFloat3(j, "max", {  10.f, 0.f,  10.f });
+    float scaleLo = 1.0f, scaleHi = 1.0f;
+    if (j.contains("scale") && j["scale"].is_array() && j["scale"].size() >= 2)
+    {
+        scaleLo = j["scale"][0].get<float>();
+        scaleHi = j["scale"][1].get<float>();
+    }
+    uint32_t state = j.contains("seed") ? j["seed"].get<uint32_t>() : 1u;
+    if (state == 0) state = 1;
+    auto next01 = [&state]
+    {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    };
+
+    out.reserve(out.size() + (count > 0 ? static_cast<size_t>(count) : 0));
+    for (int i = 0; i < count; ++i)
+    {
+        SceneDescriptor::InstanceDesc inst;
+        for (int a = 0; a < 3; ++a) inst.position[a] = mn[a] + (mx[a] - mn[a]) * next01();
+        inst.rotation[1] = 360.0f * next01();
+        inst.scale       = scaleLo + (scaleHi - scaleLo) * next01();
+        out.push_back(inst);
+    }
+}
+
+bool SceneLoader::LoadJson(const std::string& path, SceneDescriptor& out)
 {
     std::ifstream file(path);
     if (!file.is_open())
@@ -121,6 +177,7 @@ bool SceneLoader::LoadFromFile(const std::string& path, SceneDescriptor& out)
         out.physics.characterSpawn = ReadFloat3(p, "characterSpawn", out.physics.characterSpawn);
         if (p.contains("ballRadius")) out.physics.ballRadius = p["ballRadius"].get<float>();
         if (p.contains("gravity"))    out.physics.gravity    = p["gravity"].get<bool>();
+        if (p.contains("meshCollision")) out.physics.meshCollision = p["meshCollision"].get<bool>();
     }
 
     // Tone mapping
@@ -178,6 +235,35 @@ bool SceneLoader::LoadFromFile(const std::string& path, SceneDescriptor& out)
             out.objects.push_back(o);
         }
     }
+    // Prefabs and their placements
+    if (root.contains("prefabs") && root["prefabs"].is_array())
+    {
+        for (auto& p : root["prefabs"])
+        {
+            SceneDescriptor::PrefabDesc d;
+            if (p.contains("name"))        d.name        = p["name"].get<std::string>();
+            if (p.contains("mesh"))        d.mesh        = p["mesh"].get<std::string>();
+            if (p.contains("alphaCutoff")) d.alphaCutoff = p["alphaCutoff"].get<float>();
+            out.prefabs.push_back(d);
+        }
+    }
+    if (root.contains("placements") && root["placements"].is_array())
+    {
+        for (auto& p : root["placements"])
+        {
+            SceneDescriptor::PlacementDesc d;
+            if (p.contains("prefab")) d.prefab = p["prefab"].get<std::string>();
+            if (p.contains("instances") && p["instances"].is_array())
+            {
+                d.instances.reserve(p["instances"].size());
+                for (auto& inst : p["instances"])
+                    d.instances.push_back(ReadInstance(inst));
+            }
+            if (p.contains("scatter")) ExpandScatter(p["scatter"], d.instances);
+            out.placements.push_back(std::move(d));
+        }
+    }
+
     // Particles
     if (root.contains("particles") && root["particles"].is_array())
     {
@@ -211,6 +297,493 @@ bool SceneLoader::LoadFromFile(const std::string& path, SceneDescriptor& out)
     return true;
 }
 
+bool SceneLoader::LoadFromFile(const std::string& path, SceneDescriptor& out)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    const fs::path p(path);
+    if (p.extension() == ".fxscene")
+        return LoadCooked(path, out);
+
+    // Use the cooked copy unless the JSON has been edited since.
+    const std::string cooked = GetCookedPath(path);
+    const auto jsonTime   = fs::last_write_time(p, ec);
+    const bool jsonTimeOk = !ec;
+    const auto cookedTime = fs::last_write_time(cooked, ec);
+    if (!ec && jsonTimeOk && cookedTime >= jsonTime && LoadCooked(cooked, out))
+        return true;
+
+    return LoadJson(path, out);
+}
+
+// ---------------------------------------------------------------------------
+// Cooked scenes
+//
+// A header with one table entry per section, then the sections: arrays of
+// fixed-size records at 4-byte aligned offsets, no pointers, so the file
+// can be read or mapped anywhere. Strings are {offset, length} into the
+// string section. Point lights and placement instances are stored in the
+// descriptor's own layout and copied across whole. Little-endian only.
+// Bump k_CookedVersion whenever a record changes; the header also carries
+// each record size, which the loader checks.
+
+namespace {
+
+constexpr char     k_CookedMagic[4] = { 'F', 'X', 'S', 'C' };
+constexpr uint32_t k_CookedVersion  = 1;
+
+enum class CookedSection : uint32_t
+{
+    Globals, Strings, PointLights, Objects, Prefabs, Placements, Instances, Particles,
+    Count
+};
+constexpr uint32_t k_SectionCount = static_cast<uint32_t>(CookedSection::Count);
+
+struct CookedString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct CookedSectionEntry
+{
+    uint32_t offset;
+    uint32_t count;
+    uint32_t stride; // record size
+};
+
+struct CookedHeader
+{
+    char               magic[4];
+    uint32_t           version;
+    uint32_t           fileSize;
+    uint32_t           sectionCount;
+    CookedSectionEntry sections[k_SectionCount];
+};
+
+// Everything in SceneDescriptor that isn't an array.
+struct CookedGlobals
+{
+    CookedString                     name;
+    CookedString                     meshPath;
+    CookedString                     skybox;
+    CookedString                     reflectionPanorama;
+    std::array<float, 3>             meshPosition;
+    std::array<float, 3>             meshRotation;
+    float                            meshScale;
+    float                            meshAlphaCutoff;
+    SceneDescriptor::CameraDesc      camera;
+    SceneDescriptor::SunDesc         sun;
+    float                            iblIntensity;
+    SceneDescriptor::PhysicsDesc     physics;
+    SceneDescriptor::ToneMappingDesc toneMapping;
+    SceneDescriptor::BloomDesc       bloom;
+};
+
+struct CookedObject
+{
+    uint32_t             type;
+    std::array<float, 3> position;
+    float                radius;
+    float                halfSizeX;
+    float                halfSizeZ;
+    CookedString         albedoPath;
+    CookedString         normalPath;
+    CookedString         roughnessPath;
+    CookedString         metallicPath;
+    CookedString         emissivePath;
+    float                emissiveIntensity;
+    std::array<float, 3> emissiveColor;
+    std::array<float, 3> tint;
+};
+
+struct CookedPrefab
+{
+    CookedString name;
+    CookedString mesh;
+    float        alphaCutoff;
+};
+
+// Instances [firstInstance, firstInstance + instanceCount) of the instance section.
+struct CookedPlacement
+{
+    CookedString prefab;
+    uint32_t     firstInstance;
+    uint32_t     instanceCount;
+};
+
+struct CookedParticle
+{
+    CookedString         texture;
+    std::array<float, 3> position;
+    float                emitRate;
+    int32_t              maxParticles;
+    float                lifetimeMin;
+    float                lifetimeMax;
+    std::array<float, 3> velocityMin;
+    std::array<float, 3> velocityMax;
+    float                sizeStart;
+    float                sizeEnd;
+    std::array<float, 4> colorStart;
+    std::array<float, 4> colorEnd;
+    std::array<float, 3> gravity;
+    float                spawnRadius;
+    int32_t              atlasColumns;
+    int32_t              atlasRows;
+    int32_t              atlasFrameCount;
+    float                atlasSpeed;
+    float                softDistance;
+};
+
+static_assert(std::is_trivially_copyable<CookedGlobals>::value &&
+              std::is_trivially_copyable<SceneDescriptor::PointLightDesc>::value &&
+              std::is_trivially_copyable<SceneDescriptor::InstanceDesc>::value,
+              "cooked records are copied as raw bytes");
+
+constexpr uint32_t k_SectionStride[k_SectionCount] = {
+    sizeof(CookedGlobals),
+    1,
+    sizeof(SceneDescriptor::PointLightDesc),
+    sizeof(CookedObject),
+    sizeof(CookedPrefab),
+    sizeof(CookedPlacement),
+    sizeof(SceneDescriptor::InstanceDesc),
+    sizeof(CookedParticle),
+};
+
+} // namespace
+
+bool SceneLoader::SaveCooked(const SceneDescriptor& desc, const std::string& path)
+{
+    std::string strings;
+    auto str = [&strings](const std::string& s)
+    {
+        CookedString r = { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(s.size()) };
+        strings += s;
+        return r;
+    };
+
+    // Zeroed first so padding is deterministic and cooking is reproducible.
+    CookedGlobals g;
+    std::memset(static_cast<void*>(&g), 0, sizeof(g));
+    g.name               = str(desc.name);
+    g.meshPath           = str(desc.mesh.path);
+    g.skybox             = str(desc.skybox);
+    g.reflectionPanorama = str(desc.reflectionPanorama);
+    g.meshPosition       = desc.mesh.position;
+    g.meshRotation       = desc.mesh.rotation;
+    g.meshScale          = desc.mesh.scale;
+    g.meshAlphaCutoff    = desc.mesh.alphaCutoff;
+    g.camera             = desc.camera;
+    g.sun                = desc.sun;
+    g.iblIntensity       = desc.iblIntensity;
+    g.physics            = desc.physics;
+    g.toneMapping        = desc.toneMapping;
+    g.bloom              = desc.bloom;
+
+    std::vector<SceneDescriptor::PointLightDesc> lights(desc.pointLights.size());
+    std::memset(static_cast<void*>(lights.data()), 0, lights.size() * sizeof(lights[0]));
+    for (size_t i = 0; i < lights.size(); ++i) lights[i] = desc.pointLights[i];
+
+    std::vector<CookedObject> objects(desc.objects.size());
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        const auto& o = desc.objects[i];
+        CookedObject& c = objects[i];
+        c.type              = static_cast<uint32_t>(o.type);
+        c.position          = o.position;
+        c.radius            = o.radius;
+        c.halfSizeX         = o.halfSizeX;
+        c.halfSizeZ         = o.halfSizeZ;
+        c.albedoPath        = str(o.albedoPath);
+        c.normalPath        = str(o.normalPath);
+        c.roughnessPath     = str(o.roughnessPath);
+        c.metallicPath      = str(o.metallicPath);
+        c.emissivePath      = str(o.emissivePath);
+        c.emissiveIntensity = o.emissiveIntensity;
+        c.emissiveColor     = o.emissiveColor;
+        c.tint              = o.tint;
+    }
+
+    std::vector<CookedPrefab> prefabs(desc.prefabs.size());
+    for (size_t i = 0; i < prefabs.size(); ++i)
+    {
+        prefabs[i].name        = str(desc.prefabs[i].name);
+        prefabs[i].mesh        = str(desc.prefabs[i].mesh);
+        prefabs[i].alphaCutoff = desc.prefabs[i].alphaCutoff;
+    }
+
+    std::vector<CookedPlacement>              placements(desc.placements.size());
+    std::vector<SceneDescriptor::InstanceDesc> instances;
+    for (size_t i = 0; i < placements.size(); ++i)
+    {
+        const auto& p = desc.placements[i];
+        placements[i].prefab        = str(p.prefab);
+        placements[i].firstInstance = static_cast<uint32_t>(instances.size());
+        placements[i].instanceCount = static_cast<uint32_t>(p.instances.size());
+        instances.insert(instances.end(), p.instances.begin(), p.instances.end());
+    }
+
+    std::vector<CookedParticle> particles(desc.particles.size());
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        const auto& e = desc.particles[i];
+        CookedParticle& c = particles[i];
+        c.texture         = str(e.texture);
+        c.position        = e.position;
+        c.emitRate        = e.emitRate;
+        c.maxParticles    = e.maxParticles;
+        c.lifetimeMin     = e.lifetimeMin;
+        c.lifetimeMax     = e.lifetimeMax;
+        c.velocityMin     = e.velocityMin;
+        c.velocityMax     = e.velocityMax;
+        c.sizeStart       = e.sizeStart;
+        c.sizeEnd         = e.sizeEnd;
+        c.colorStart      = e.colorStart;
+        c.colorEnd        = e.colorEnd;
+        c.gravity         = e.gravity;
+        c.spawnRadius     = e.spawnRadius;
+        c.atlasColumns    = e.atlasColumns;
+        c.atlasRows       = e.atlasRows;
+        c.atlasFrameCount = e.atlasFrameCount;
+        c.atlasSpeed      = e.atlasSpeed;
+        c.softDistance    = e.softDistance;
+    }
+
+    // Lay the sections out after the header.
+    CookedHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, k_CookedMagic, sizeof(header.magic));
+    header.version      = k_CookedVersion;
+    header.sectionCount = k_SectionCount;
+
+    std::vector<char> file(sizeof(CookedHeader));
+    auto section = [&file, &header](CookedSection id, const void* data, size_t count)
+    {
+        CookedSectionEntry& e = header.sections[static_cast<uint32_t>(id)];
+        file.resize((file.size() + 3) & ~static_cast<size_t>(3));
+        e.offset = static_cast<uint32_t>(file.size());
+        e.count  = static_cast<uint32_t>(count);
+        e.stride = k_SectionStride[static_cast<uint32_t>(id)];
+        const char* bytes = static_cast<const char*>(data);
+        file.insert(file.end(), bytes, bytes + count * e.stride);
+    };
+    section(CookedSection::Globals,     &g,                1);
+    section(CookedSection::Strings,     strings.data(),    strings.size());
+    section(CookedSection::PointLights, lights.data(),     lights.size());
+    section(CookedSection::Objects,     objects.data(),    objects.size());
+    section(CookedSection::Prefabs,     prefabs.data(),    prefabs.size());
+    section(CookedSection::Placements,  placements.data(), placements.size());
+    section(CookedSection::Instances,   instances.data(),  instances.size());
+    section(CookedSection::Particles,   particles.data(),  particles.size());
+
+    if (file.size() > UINT32_MAX)
+    {
+        SE_LOG_ERROR("SceneLoader: '%s' is too large to cook", path.c_str());
+        return false;
+    }
+    header.fileSize = static_cast<uint32_t>(file.size());
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open() || !out.write(file.data(), static_cast<std::streamsize>(file.size())))
+    {
+        SE_LOG_ERROR("SceneLoader: Failed to write '%s'", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SceneLoader::LoadCooked(const std::string& path, SceneDescriptor& out)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        SE_LOG_ERROR("SceneLoader: Failed to open '%s'", path.c_str());
+        return false;
+    }
+    const std::streamoff fileSize = file.tellg();
+    if (fileSize < static_cast<std::streamoff>(sizeof(CookedHeader)) || fileSize > UINT32_MAX)
+    {
+        SE_LOG_ERROR("SceneLoader: '%s' is not a cooked scene", path.c_str());
+        return false;
+    }
+
+    // One read; every record below is used where it lies.
+    const size_t size = static_cast<size_t>(fileSize);
+    std::unique_ptr<char[]> data(new char[size]);
+    file.seekg(0);
+    if (!file.read(data.get(), static_cast<std::streamsize>(size)))
+    {
+        SE_LOG_ERROR("SceneLoader: Failed to read '%s'", path.c_str());
+        return false;
+    }
+    const char* base = data.get();
+
+    const CookedHeader& header = *reinterpret_cast<const CookedHeader*>(base);
+    if (std::memcmp(header.magic, k_CookedMagic, sizeof(header.magic)) != 0 ||
+        header.version != k_CookedVersion || header.fileSize != size ||
+        header.sectionCount != k_SectionCount)
+    {
+        SE_LOG_ERROR("SceneLoader: '%s' is not a version %u cooked scene", path.c_str(), k_CookedVersion);
+        return false;
+    }
+    for (uint32_t i = 0; i < k_SectionCount; ++i)
+    {
+        const CookedSectionEntry& e = header.sections[i];
+        if (e.stride != k_SectionStride[i] || (e.offset & 3) != 0 ||
+            static_cast<uint64_t>(e.offset) + static_cast<uint64_t>(e.count) * e.stride > size)
+        {
+            SE_LOG_ERROR("SceneLoader: '%s' has a bad section table", path.c_str());
+            return false;
+        }
+    }
+
+    auto records = [&](CookedSection id, uint32_t& count)
+    {
+        const CookedSectionEntry& e = header.sections[static_cast<uint32_t>(id)];
+        count = e.count;
+        return base + e.offset;
+    };
+
+    uint32_t    stringsSize = 0;
+    const char* strings     = records(CookedSection::Strings, stringsSize);
+    bool        stringsOk   = true;
+    auto str = [&](const CookedString& s, std::string& dst)
+    {
+        if (static_cast<uint64_t>(s.offset) + s.length > stringsSize) { stringsOk = false; return; }
+        dst.assign(strings + s.offset, s.length);
+    };
+
+    uint32_t count = 0;
+    const auto* g = reinterpret_cast<const CookedGlobals*>(records(CookedSection::Globals, count));
+    if (count != 1)
+    {
+        SE_LOG_ERROR("SceneLoader: '%s' has no globals", path.c_str());
+        return false;
+    }
+
+    out = SceneDescriptor{};
+    str(g->name,               out.name);
+    str(g->meshPath,           out.mesh.path);
+    str(g->skybox,             out.skybox);
+    str(g->reflectionPanorama, out.reflectionPanorama);
+    out.mesh.position    = g->meshPosition;
+    out.mesh.rotation    = g->meshRotation;
+    out.mesh.scale       = g->meshScale;
+    out.mesh.alphaCutoff = g->meshAlphaCutoff;
+    out.camera           = g->camera;
+    out.sun              = g->sun;
+    out.iblIntensity     = g->iblIntensity;
+    out.physics          = g->physics;
+    out.toneMapping      = g->toneMapping;
+    out.bloom            = g->bloom;
+
+    const auto* lights = reinterpret_cast<const SceneDescriptor::PointLightDesc*>(records(CookedSection::PointLights, count));
+    out.pointLights.assign(lights, lights + count);
+
+    const auto* objects = reinterpret_cast<const CookedObject*>(records(CookedSection::Objects, count));
+    out.objects.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const CookedObject& c = objects[i];
+        SceneDescriptor::SceneObject& o = out.objects[i];
+        o.type = c.type == static_cast<uint32_t>(SceneDescriptor::SceneObject::Type::Plane)
+            ? SceneDescriptor::SceneObject::Type::Plane : SceneDescriptor::SceneObject::Type::Sphere;
+        o.position          = c.position;
+        o.radius            = c.radius;
+        o.halfSizeX         = c.halfSizeX;
+        o.halfSizeZ         = c.halfSizeZ;
+        str(c.albedoPath,    o.albedoPath);
+        str(c.normalPath,    o.normalPath);
+        str(c.roughnessPath, o.roughnessPath);
+        str(c.metallicPath,  o.metallicPath);
+        str(c.emissivePath,  o.emissivePath);
+        o.emissiveIntensity = c.emissiveIntensity;
+        o.emissiveColor     = c.emissiveColor;
+        o.tint              = c.tint;
+    }
+
+    const auto* prefabs = reinterpret_cast<const CookedPrefab*>(records(CookedSection::Prefabs, count));
+    out.prefabs.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        str(prefabs[i].name, out.prefabs[i].name);
+        str(prefabs[i].mesh, out.prefabs[i].mesh);
+        out.prefabs[i].alphaCutoff = prefabs[i].alphaCutoff;
+    }
+
+    uint32_t instanceCount = 0;
+    const auto* instances  = reinterpret_cast<const SceneDescriptor::InstanceDesc*>(records(CookedSection::Instances, instanceCount));
+    const auto* placements = reinterpret_cast<const CookedPlacement*>(records(CookedSection::Placements, count));
+    out.placements.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const CookedPlacement& c = placements[i];
+        if (static_cast<uint64_t>(c.firstInstance) + c.instanceCount > instanceCount)
+        {
+            SE_LOG_ERROR("SceneLoader: '%s' has a bad placement", path.c_str());
+            return false;
+        }
+        str(c.prefab, out.placements[i].prefab);
+        out.placements[i].instances.assign(instances + c.firstInstance,
+                                           instances + c.firstInstance + c.instanceCount);
+    }
+
+    const auto* particles = reinterpret_cast<const CookedParticle*>(records(CookedSection::Particles, count));
+    out.particles.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const CookedParticle& c = particles[i];
+        SceneDescriptor::ParticleEmitterDesc& e = out.particles[i];
+        str(c.texture, e.texture);
+        e.position        = c.position;
+        e.emitRate        = c.emitRate;
+        e.maxParticles    = c.maxParticles;
+        e.lifetimeMin     = c.lifetimeMin;
+        e.lifetimeMax     = c.lifetimeMax;
+        e.velocityMin     = c.velocityMin;
+        e.velocityMax     = c.velocityMax;
+        e.sizeStart       = c.sizeStart;
+        e.sizeEnd         = c.sizeEnd;
+        e.colorStart      = c.colorStart;
+        e.colorEnd        = c.colorEnd;
+        e.gravity         = c.gravity;
+        e.spawnRadius     = c.spawnRadius;
+        e.atlasColumns    = c.atlasColumns;
+        e.atlasRows       = c.atlasRows;
+        e.atlasFrameCount = c.atlasFrameCount;
+        e.atlasSpeed      = c.atlasSpeed;
+        e.softDistance    = c.softDistance;
+    }
+
+    if (!stringsOk)
+    {
+        SE_LOG_ERROR("SceneLoader: '%s' has a bad string reference", path.c_str());
+        return false;
+    }
+
+    SE_LOG_INFO("SceneLoader: Loaded '%s' (%s)", out.name.c_str(), path.c_str());
+    return true;
+}
+
+std::string SceneLoader::GetCookedPath(const std::string& jsonPath)
+{
+    return std::filesystem::path(jsonPath).replace_extension(".fxscene").string();
+}
+
+bool SceneLoader::Cook(const std::string& jsonPath)
+{
+    SceneDescriptor desc;
+    if (!LoadJson(jsonPath, desc)) return false;
+
+    const std::string cooked = GetCookedPath(jsonPath);
+    if (!SaveCooked(desc, cooked)) return false;
+    SE_LOG_INFO("SceneLoader: Cooked '%s' -> '%s'", jsonPath.c_str(), cooked.c_str());
+    return true;
+}
+
 std::vector<std::string> SceneLoader::ScanSceneDirectory(const std::string& directory)
 {
     std::vector<std::string> results;
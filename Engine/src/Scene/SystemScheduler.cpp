@@ -0,0 +1,59 @@
+#include "Engine/Scene/SystemScheduler.h"
+#include <algorithm>
+
+namespace SE {
+
+static bool Overlaps(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+{
+    for (uint32_t x : a)
+        if (std::find(b.begin(), b.end(), x) != b.end()) return true;
+    return false;
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+{
+    return Overlaps(writes, other.writes)
+        || Overlaps(writes, other.reads)
+        || Overlaps(reads, other.writes);
+}
+
+void SystemScheduler::Add(System system)
+{
+    // Edges only point back at earlier systems, so phases can be assigned as
+    // systems arrive.
+    uint32_t phase = 0;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_systems.size()); ++i)
+        if (system.access.ConflictsWith(m_systems[i].access) && m_phaseOf[i] + 1 > phase)
+            phase = m_phaseOf[i] + 1;
+
+    const uint32_t index = static_cast<uint32_t>(m_systems.size());
+    m_systems.push_back(std::move(system));
+    m_phaseOf.push_back(phase);
+    if (phase == m_phases.size()) m_phases.emplace_back();
+    m_phases[phase].push_back(index);
+}
+
+void SystemScheduler::Run(float dt)
+{
+    const auto runTask = [this, dt](uint32_t i)
+    {
+        const Task& task = m_tasks[i];
+        m_systems[task.system].run(task.chunk, dt);
+    };
+
+    for (const std::vector<uint32_t>& phase : m_phases)
+    {
+        m_tasks.clear();
+        for (uint32_t s : phase)
+        {
+            const uint32_t chunks = m_systems[s].chunkCount();
+            for (uint32_t c = 0; c < chunks; ++c)
+                m_tasks.push_back({ s, c });
+        }
+
+        const uint32_t count = static_cast<uint32_t>(m_tasks.size());
+        ParallelFor(m_jobs, count, 1, runTask);
+    }
+}
+
+} // namespace SE
@@ -1,14 +1,31 @@
 #include "Engine/Scene/TransformComponent.h"
+#include "Engine/Scene/Entity.h"
 #include <algorithm>
 
 namespace SE {
 
+using namespace DirectX;
+
+TransformComponent::~TransformComponent()
+{
+    Unparent();
+    if (children.empty()) return;
+    for (TransformComponent* child : children)
+    {
+        child->parent = nullptr;
+        child->InvalidateWorld();
+    }
+    HierarchyChanged();
+}
+
 void TransformComponent::SetParent(TransformComponent* newParent)
 {
     Unparent();
     parent = newParent;
     if (parent)
         parent->children.push_back(this);
+    InvalidateWorld();
+    HierarchyChanged();
 }
 
 void TransformComponent::Unparent()
@@ -17,6 +34,52 @@ void TransformComponent::Unparent()
     auto& siblings = parent->children;
     siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
     parent = nullptr;
+    InvalidateWorld();
+    HierarchyChanged();
+}
+
+void TransformComponent::HierarchyChanged() const
+{
+    if (m_owner) m_owner->GetRegistry()->BumpHierarchyVersion();
+}
+
+const XMFLOAT4X4& TransformComponent::GetWorld() const
+{
+    XMMATRIX local = GetLocalMatrix(); // may flag us dirty
+    if (m_worldDirty)
+    {
+        // The parent is rebuilt first, and may flag us again on the way; we are
+        // up to date with it either way once stored.
+        XMMATRIX world = parent ? local * parent->GetWorldMatrix() : local;
+        XMStoreFloat4x4(&m_world, world);
+        m_worldDirty = false;
+    }
+    return m_world;
+}
+
+void TransformComponent::RebuildLocal() const
+{
+    XMMATRIX m = XMMatrixScaling(scale, scale, scale)
+               * XMMatrixRotationRollPitchYaw(
+                     XMConvertToRadians(eulerDeg.x),
+                     XMConvertToRadians(eulerDeg.y),
+                     XMConvertToRadians(eulerDeg.z))
+               * XMMatrixTranslation(position.x, position.y, position.z);
+    XMStoreFloat4x4(&m_local, m);
+
+    m_builtPosition = position;
+    m_builtEuler    = eulerDeg;
+    m_builtScale    = scale;
+    m_localValid    = true;
+    InvalidateWorld();
+}
+
+void TransformComponent::InvalidateWorld() const
+{
+    if (m_worldDirty) return;
+    m_worldDirty = true;
+    for (TransformComponent* child : children)
+        child->InvalidateWorld();
 }
 
 } // namespace SE
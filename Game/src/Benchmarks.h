@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+// Headless benchmarks, run via `TestGame.exe --bench <name>` (or `--bench all`).
+// No window or D3D device is created; results go to FoxEngine_bench.log.
+namespace Bench {
+
+// Returns the process exit code (0 = ran, 1 = unknown benchmark name).
+int Run(const std::string& name);
+
+} // namespace Bench
@@ -3,8 +3,11 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <filesystem>
+#include <unordered_map>
 #include "Engine/Core/Engine.h"
 #include "Engine/Core/Logger.h"
 #include "Engine/Assets/AssetManager.h"
@@ -20,8 +23,10 @@
 #include "Engine/Scene/Camera/CameraController.h"
 #include "Engine/Physics/RigidBodyComponent.h"
 #include "Engine/Physics/PhysicsWorld.h"
+#include "Engine/Physics/TriangleMesh.h"
 #include "Engine/Renderer/LightEnvironment.h"
 #include "Engine/Renderer/ForwardPipeline.h"
+#include "Engine/Renderer/MeshRendererComponent.h"
 #include "Engine/Renderer/SkyboxRenderer.h"
 #include "Engine/Renderer/CascadedShadowMap.h"
 #include "Engine/Renderer/RenderTarget.h"
@@ -33,12 +38,16 @@
 #include "Engine/Renderer/FXAA.h"
 #include "Engine/Renderer/ParticleSystem.h"
 #include "Engine/Renderer/SpotLight.h"
+#include "Engine/Renderer/VisibilityIndex.h"
 #include "Engine/Input/GamepadState.h"
+#include "Benchmarks.h"
 
 using namespace DirectX;
 
 class TestScene : public SE::Engine
 {
+    struct PendingScene; // a scene being streamed in; see RequestScene
+
 public:
     bool Setup(const std::string& scenePath = "")
     {
@@ -46,7 +55,7 @@ public:
 
         if (!m_skybox.Init(device, GetRenderer().GetStateCache(), GetShaders())) return false;
         if (!m_lights.Init(device))                return false;
-        if (!m_pipeline.Init(device, GetAssets(), GetShaders())) return false;
+        if (!m_pipeline.Init(device, GetAssets(), GetShaders(), GetFrameArena())) return false;
         if (!m_shadowMap.Init(device, GetShaders(), 2048)) return false;
 
         // Forward HDR render target (owns its own depth buffer, depth is readable for SSR)
@@ -109,50 +118,296 @@ public:
         return true;
     }
 
+    // Blocking load, for startup: the streamed path below, run to completion.
     bool ApplyScene(const std::string& scenePath)
     {
-        SE::SceneDescriptor desc;
-        if (!SE::SceneLoader::LoadFromFile(scenePath, desc))
-            return false;
+        std::shared_ptr<PendingScene> p = RequestScene(scenePath);
+        GetLoader().Flush();
+        return p->committed;
+    }
 
-        // Track current scene
-        m_currentScenePath = scenePath;
-        m_currentDesc      = desc;
-        for (int i = 0; i < (int)m_sceneFiles.size(); ++i)
-            if (m_sceneFiles[i] == scenePath) { m_selectedScene = i; break; }
+    // Switches scene without stalling the frame. The loader thread parses the
+    // descriptor and loads everything that needs only the device (PrepareScene);
+    // StreamScene then builds the new Scene a slice at a time within the
+    // loader's frame budget and CommitScene swaps it in whole, so the old one
+    // keeps rendering until then. A newer request abandons this one.
+    std::shared_ptr<PendingScene> RequestScene(const std::string& scenePath)
+    {
+        if (m_streaming) m_streaming->cancelled = true;
 
-        ID3D11Device* device = GetRenderer().GetDevice();
+        auto p = std::make_shared<PendingScene>();
+        p->path       = scenePath;
+        p->start      = std::chrono::steady_clock::now();
+        p->startFrame = GetClock().GetFrameCount();
+        m_streaming   = p;
+
+        GetLoader().Enqueue([this, p]
+        {
+            PrepareScene(*p);
+            GetLoader().Post([this, p] { return StreamScene(*p); });
+        });
+        return p;
+    }
+
+    // Loader thread.
+    void PrepareScene(PendingScene& p)
+    {
+        if (p.cancelled) return;
+        if (!SE::SceneLoader::LoadFromFile(p.path, p.desc))
+            return;
+        const SE::SceneDescriptor& desc = p.desc;
+        auto toW = [](const std::string& s) { return std::wstring(s.begin(), s.end()); };
 
         // --- Skybox ---
-        std::wstring skyboxW(desc.skybox.begin(), desc.skybox.end());
         if (!desc.skybox.empty())
-            m_skybox.LoadPanorama(device, skyboxW.c_str());
+            SE::SkyboxRenderer::LoadPanoramaSRV(GetRenderer().GetDevice(), toW(desc.skybox).c_str(), p.skybox);
 
-        // --- Mesh ---
-        m_mesh.reset();
-        m_subMats.clear();
+        // --- Mesh, and its collider in world space ---
         if (!desc.mesh.path.empty())
         {
-            m_mesh = GetAssets().GetMesh(desc.mesh.path);
-            if (m_mesh)
+            p.mesh = GetAssets().GetMesh(desc.mesh.path, desc.physics.meshCollision);
+            if (p.mesh)
             {
-                m_subMats = m_pipeline.LoadMeshMaterials(GetAssets(), *m_mesh);
-                // Apply scene-level alpha cutoff override
-                if (desc.mesh.alphaCutoff > 0.0f)
-                {
-                    for (auto& sm : m_subMats)
-                    {
-                        if (sm.alphaMode == SE::AlphaMode::Opaque && sm.albedo && sm.albedo->HasAlpha())
-                        {
-                            sm.alphaMode   = SE::AlphaMode::Cutout;
-                            sm.alphaCutoff = desc.mesh.alphaCutoff;
-                        }
-                    }
-                }
+                p.subMats = m_pipeline.LoadMeshMaterials(GetAssets(), *p.mesh);
+                ApplyAlphaCutoff(p.subMats, desc.mesh.alphaCutoff);
             }
             else
                 SE_LOG_WARN("Failed to load mesh: %s", desc.mesh.path.c_str());
         }
+        if (p.mesh && desc.physics.meshCollision && !p.cancelled)
+        {
+            SE::TransformComponent placement;
+            placement.position = { desc.mesh.position[0], desc.mesh.position[1], desc.mesh.position[2] };
+            placement.eulerDeg = { desc.mesh.rotation[0], desc.mesh.rotation[1], desc.mesh.rotation[2] };
+            placement.scale    = desc.mesh.scale;
+
+            const auto& pos = p.mesh->GetCPUPositions();
+            const auto& idx = p.mesh->GetCPUIndices();
+            auto collider = std::make_shared<SE::TriangleMesh>();
+            collider->Build(pos.data(), static_cast<uint32_t>(pos.size()),
+                            idx.data(), static_cast<uint32_t>(idx.size()),
+                            placement.GetLocalMatrix());
+            SE_LOG_INFO("Mesh collider: %u triangles, %u BVH nodes",
+                collider->GetTriangleCount(), collider->GetBVH().GetNodeCount());
+            p.collider = collider;
+        }
+
+        // --- JSON scene objects (spheres / planes with explicit PBR textures) ---
+        for (auto& obj : desc.objects)
+        {
+            if (p.cancelled) return;
+            LoadedObject lo;
+            lo.def           = obj;
+            lo.mat.albedo    = obj.albedoPath.empty()    ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.albedoPath));
+            lo.mat.normal    = obj.normalPath.empty()    ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.normalPath));
+            lo.mat.roughness = obj.roughnessPath.empty() ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.roughnessPath));
+            lo.mat.metallic  = obj.metallicPath.empty()  ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.metallicPath));
+            lo.mat.emissive  = obj.emissivePath.empty()  ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.emissivePath));
+            p.objects.push_back(std::move(lo));
+        }
+
+        // --- Prefabs, and one instance batch per placement ---
+        for (auto& pd : desc.prefabs)
+        {
+            if (p.cancelled) return;
+            PrefabAssets& pa = p.prefabAssets[pd.name];
+            pa.mesh = GetAssets().GetMesh(pd.mesh);
+            if (!pa.mesh)
+            {
+                SE_LOG_WARN("Prefab '%s': failed to load mesh %s", pd.name.c_str(), pd.mesh.c_str());
+                continue;
+            }
+            pa.mats = m_pipeline.LoadMeshMaterials(GetAssets(), *pa.mesh);
+            ApplyAlphaCutoff(pa.mats, pd.alphaCutoff);
+        }
+        for (auto& pl : desc.placements)
+        {
+            auto it = p.prefabAssets.find(pl.prefab);
+            if (it == p.prefabAssets.end() || !it->second.mesh)
+            {
+                SE_LOG_WARN("Placement: unknown prefab '%s'", pl.prefab.c_str());
+                continue;
+            }
+            // The materials live in the map node, which stays put when the
+            // map moves into m_prefabAssets.
+            SE::MeshRendererComponent renderer;
+            renderer.mesh      = it->second.mesh;
+            renderer.materials = &it->second.mats;
+
+            PendingScene::Batch batch{ SE::Prefab(pl.prefab), {} };
+            batch.prefab.Add(renderer);
+            batch.transforms.resize(pl.instances.size());
+            for (size_t i = 0; i < pl.instances.size(); ++i)
+            {
+                const auto& inst = pl.instances[i];
+                batch.transforms[i].position = { inst.position[0], inst.position[1], inst.position[2] };
+                batch.transforms[i].eulerDeg = { inst.rotation[0], inst.rotation[1], inst.rotation[2] };
+                batch.transforms[i].scale    = inst.scale;
+            }
+            p.batches.push_back(std::move(batch));
+        }
+
+        // --- Particle textures ---
+        p.particleTextures.resize(desc.particles.size());
+        for (size_t i = 0; i < desc.particles.size(); ++i)
+        {
+            if (p.cancelled) return;
+            if (!desc.particles[i].texture.empty())
+                p.particleTextures[i] = GetAssets().GetTexture(toW(desc.particles[i].texture));
+        }
+
+        p.loaded = true;
+    }
+
+    // Main thread, from the loader's Pump: one bounded slice per call, true
+    // once the scene is in (or has been given up).
+    bool StreamScene(PendingScene& p)
+    {
+        static constexpr uint32_t k_InstanceSlice = 4096;
+        static constexpr size_t   k_EmitterSlice  = 16;
+
+        if (p.cancelled) return true;
+        if (!p.loaded)
+        {
+            SE_LOG_ERROR("Scene '%s' failed to load; keeping the current one", p.path.c_str());
+            if (m_streaming.get() == &p) m_streaming.reset();
+            return true;
+        }
+
+        switch (p.stage)
+        {
+        case PendingScene::Stage::Entities:
+        {
+            const SE::SceneDescriptor& desc = p.desc;
+            p.scene.GetScheduler().SetJobSystem(&GetJobs());
+
+            // Grow every pool to the level's size once, before the
+            // placement slices start creating instances. The 3 are the
+            // camera, mesh and ball entities just below.
+            std::vector<SE::PrefabCount> counts;
+            counts.reserve(p.batches.size());
+            for (const PendingScene::Batch& batch : p.batches)
+                counts.push_back({ &batch.prefab, static_cast<uint32_t>(batch.transforms.size()) });
+            p.scene.Reserve(counts.data(), static_cast<uint32_t>(counts.size()), 3);
+
+            SE::Entity* camEnt = p.scene.CreateEntity("Camera");
+            p.camera           = camEnt->AddComponent<SE::CameraComponent>();
+            p.camera->nearZ    = desc.camera.nearZ;
+            p.camera->farZ     = desc.camera.farZ;
+
+            // Mesh entity with transform
+            SE::Entity* meshEnt = p.scene.CreateEntity("SceneMesh");
+            p.meshTransform           = meshEnt->AddComponent<SE::TransformComponent>();
+            p.meshTransform->position = { desc.mesh.position[0], desc.mesh.position[1], desc.mesh.position[2] };
+            p.meshTransform->eulerDeg = { desc.mesh.rotation[0], desc.mesh.rotation[1], desc.mesh.rotation[2] };
+            p.meshTransform->scale    = desc.mesh.scale;
+
+            // Physics ball entity
+            SE::Entity* ballEnt = p.scene.CreateEntity("PhysBall");
+            p.ballTransform     = ballEnt->AddComponent<SE::TransformComponent>();
+            p.ballRigidBody     = ballEnt->AddComponent<SE::RigidBodyComponent>();
+            p.ballTransform->scale = desc.physics.ballRadius;
+
+            p.stage = PendingScene::Stage::Placements;
+            return false;
+        }
+
+        case PendingScene::Stage::Placements:
+        {
+            if (p.nextBatch == p.batches.size())
+            {
+                p.stage = PendingScene::Stage::Particles;
+                return false;
+            }
+            PendingScene::Batch& batch = p.batches[p.nextBatch];
+            const size_t left  = batch.transforms.size() - p.nextInstance;
+            const uint32_t n   = left < k_InstanceSlice ? static_cast<uint32_t>(left) : k_InstanceSlice;
+            p.scene.Instantiate(batch.prefab, batch.transforms.data() + p.nextInstance, n);
+            p.nextInstance += n;
+            if (p.nextInstance == batch.transforms.size())
+            {
+                ++p.nextBatch;
+                p.nextInstance = 0;
+            }
+            return false;
+        }
+
+        case PendingScene::Stage::Particles:
+        {
+            // ParticleSystem::Init compiles through the ShaderLibrary, which
+            // is main-thread only.
+            const auto& emitters = p.desc.particles;
+            for (size_t done = 0; done < k_EmitterSlice && p.nextEmitter < emitters.size(); ++done, ++p.nextEmitter)
+            {
+                const auto& pe = emitters[p.nextEmitter];
+                auto ps = std::make_unique<SE::ParticleSystem>();
+                ps->config.emitRate     = pe.emitRate;
+                ps->config.maxParticles = pe.maxParticles;
+                ps->config.lifetimeMin  = pe.lifetimeMin;
+                ps->config.lifetimeMax  = pe.lifetimeMax;
+                ps->config.velocityMin  = { pe.velocityMin[0], pe.velocityMin[1], pe.velocityMin[2] };
+                ps->config.velocityMax  = { pe.velocityMax[0], pe.velocityMax[1], pe.velocityMax[2] };
+                ps->config.sizeStart    = pe.sizeStart;
+                ps->config.sizeEnd      = pe.sizeEnd;
+                ps->config.colorStart   = { pe.colorStart[0], pe.colorStart[1], pe.colorStart[2], pe.colorStart[3] };
+                ps->config.colorEnd     = { pe.colorEnd[0], pe.colorEnd[1], pe.colorEnd[2], pe.colorEnd[3] };
+                ps->config.gravity      = { pe.gravity[0], pe.gravity[1], pe.gravity[2] };
+                ps->config.spawnRadius  = pe.spawnRadius;
+                ps->config.atlasColumns    = pe.atlasColumns;
+                ps->config.atlasRows       = pe.atlasRows;
+                ps->config.atlasFrameCount = pe.atlasFrameCount;
+                ps->config.atlasSpeed      = pe.atlasSpeed;
+                ps->config.softDistance    = pe.softDistance;
+                if (!ps->Init(GetRenderer().GetDevice(), GetShaders()))
+                {
+                    SE_LOG_WARN("Failed to init particle emitter");
+                    continue;
+                }
+                ps->SetPosition({ pe.position[0], pe.position[1], pe.position[2] });
+                if (p.particleTextures[p.nextEmitter])
+                    ps->SetTexture(p.particleTextures[p.nextEmitter]);
+                p.particles.push_back(std::move(ps));
+            }
+            if (p.nextEmitter == emitters.size())
+                p.stage = PendingScene::Stage::Commit;
+            return false;
+        }
+
+        case PendingScene::Stage::Commit:
+            CommitScene(p);
+            return true;
+        }
+        return true;
+    }
+
+    // Main thread: swap the finished scene in.
+    void CommitScene(PendingScene& p)
+    {
+        const SE::SceneDescriptor& desc = p.desc;
+
+        // Track current scene
+        m_currentScenePath = p.path;
+        for (int i = 0; i < (int)m_sceneFiles.size(); ++i)
+            if (m_sceneFiles[i] == p.path) { m_selectedScene = i; break; }
+
+        // The outgoing scene can be large; release it on the loader thread.
+        auto retired = std::make_shared<RetiredScene>();
+        retired->scene        = std::move(m_scene);
+        retired->prefabAssets = std::move(m_prefabAssets);
+        retired->particles    = std::move(m_particleSystems);
+        GetLoader().Enqueue([retired = std::move(retired)] {}); // freed with the work item
+
+        // --- Skybox ---
+        if (p.skybox) m_skybox.SetPanorama(std::move(p.skybox));
+
+        // --- Mesh ---
+        m_mesh    = std::move(p.mesh);
+        m_subMats = std::move(p.subMats);
+
+        // Everything indexed belonged to the outgoing scene; SyncVisibility
+        // adds the new one on the next update.
+        m_visibility.Clear();
+        m_bistroVisId = SE::VisibilityIndex::k_Invalid;
 
         // --- Lights ---
         m_lights.elevDeg        = desc.sun.elevation;
@@ -173,35 +428,29 @@ public:
             m_lightCastsShadow[i]       = pl.castShadow;
         }
 
-        // --- Scene entities (rebuild) ---
-        m_scene = SE::Scene{};
-        SE::Entity* camEnt = m_scene.CreateEntity("Camera");
-        m_camera           = camEnt->AddComponent<SE::CameraComponent>();
-        m_camera->nearZ    = desc.camera.nearZ;
-        m_camera->farZ     = desc.camera.farZ;
+        // --- Scene entities ---
+        m_scene           = std::move(p.scene);
+        m_prefabAssets    = std::move(p.prefabAssets);
+        m_particleSystems = std::move(p.particles);
+        m_sceneObjects    = std::move(p.objects);
+
+        m_camera          = p.camera;
+        m_bistroTransform = p.meshTransform;
+        m_ballTransform   = p.ballTransform;
+        m_ballRigidBody   = p.ballRigidBody;
         m_camCtrl.freeFly.eye      = { desc.camera.eye[0], desc.camera.eye[1], desc.camera.eye[2] };
         m_camCtrl.freeFly.yawDeg   = desc.camera.yaw;
         m_camCtrl.freeFly.pitchDeg = desc.camera.pitch;
         m_camCtrl.Update(0.0f, GetInput(), *m_camera, GetWindow().GetHandle());
 
-        // Mesh entity with transform
-        SE::Entity* meshEnt = m_scene.CreateEntity("SceneMesh");
-        m_bistroTransform          = meshEnt->AddComponent<SE::TransformComponent>();
-        m_bistroTransform->position = { desc.mesh.position[0], desc.mesh.position[1], desc.mesh.position[2] };
-        m_bistroTransform->eulerDeg = { desc.mesh.rotation[0], desc.mesh.rotation[1], desc.mesh.rotation[2] };
-        m_bistroTransform->scale    = desc.mesh.scale;
-
-        // Physics ball entity
-        SE::Entity* ballEnt = m_scene.CreateEntity("PhysBall");
-        m_ballTransform     = ballEnt->AddComponent<SE::TransformComponent>();
-        m_ballRigidBody     = ballEnt->AddComponent<SE::RigidBodyComponent>();
-        m_ballRadius        = desc.physics.ballRadius;
-        m_ballTransform->scale = m_ballRadius;
-        m_ballSpawn = { desc.physics.ballSpawn[0], desc.physics.ballSpawn[1], desc.physics.ballSpawn[2] };
+        m_ballRadius = desc.physics.ballRadius;
+        m_ballSpawn  = { desc.physics.ballSpawn[0], desc.physics.ballSpawn[1], desc.physics.ballSpawn[2] };
         ResetBall();
 
         // --- Physics world (rebuild) ---
         m_physicsWorld = SE::PhysicsWorld{};
+        m_physicsWorld.SetJobSystem(&GetJobs());
+        m_physicsWorld.SetFixedTimeStep(GetClock().GetFixedTimeStep());
         m_physicsWorld.AddSphere(m_ballTransform, m_ballRigidBody, m_ballRadius);
         m_floorY = desc.physics.floor.max[1];
         m_obbFloor = SE::OBB::FromAABB(
@@ -209,6 +458,10 @@ public:
             { desc.physics.floor.max[0], desc.physics.floor.max[1], desc.physics.floor.max[2] });
         m_physicsWorld.AddStaticOBB(m_obbFloor, desc.physics.floor.friction, desc.physics.floor.restitution);
 
+        m_meshCollider = std::move(p.collider);
+        if (m_meshCollider)
+            m_physicsWorld.AddStaticTriangleMesh(m_meshCollider);
+
         // Character controller
         m_cc = SE::CharacterController{};
         m_cc.position = { desc.physics.characterSpawn[0], desc.physics.characterSpawn[1], desc.physics.characterSpawn[2] };
@@ -225,77 +478,70 @@ public:
         m_bloom.intensity      = desc.bloom.intensity;
         m_bloom.scatter        = desc.bloom.scatter;
 
-        // --- JSON scene objects (spheres / planes with explicit PBR textures) ---
-        m_sceneObjects.clear();
-        for (auto& obj : desc.objects)
-        {
-            auto toW = [](const std::string& s) { return std::wstring(s.begin(), s.end()); };
-            LoadedObject lo;
-            lo.def           = obj;
-            lo.mat.albedo    = obj.albedoPath.empty()    ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.albedoPath));
-            lo.mat.normal    = obj.normalPath.empty()    ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.normalPath));
-            lo.mat.roughness = obj.roughnessPath.empty() ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.roughnessPath));
-            lo.mat.metallic  = obj.metallicPath.empty()  ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.metallicPath));
-            lo.mat.emissive  = obj.emissivePath.empty()  ? SE::AssetHandle<SE::Texture2D>{} : GetAssets().GetTexture(toW(obj.emissivePath));
-            m_sceneObjects.push_back(std::move(lo));
-        }
+        // Update window title
+        std::wstring title = L"FoxEngine " + std::wstring(desc.name.begin(), desc.name.end());
+        SetWindowTextW(GetWindow().GetHandle(), title.c_str());
+
+        SE_LOG_INFO("Scene '%s' ready in %.1f ms over %llu frames (%zu entities)", desc.name.c_str(),
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - p.start).count(),
+            GetClock().GetFrameCount() - p.startFrame, m_scene.GetEntities().size());
 
-        // --- Particle emitters (from scene JSON) ---
-        m_particleSystems.clear();
-        for (auto& pe : desc.particles)
+        m_currentDesc = std::move(p.desc);
+        p.committed   = true;
+        if (m_streaming.get() == &p) m_streaming.reset();
+    }
+
+    // Scene-level alpha cutoff override: alpha-test opaque submeshes whose albedo has alpha.
+    static void ApplyAlphaCutoff(std::vector<SE::ForwardPipeline::SubMat>& mats, float cutoff)
+    {
+        if (cutoff <= 0.0f) return;
+        for (auto& sm : mats)
         {
-            auto ps = std::make_unique<SE::ParticleSystem>();
-            ps->config.emitRate     = pe.emitRate;
-            ps->config.maxParticles = pe.maxParticles;
-            ps->config.lifetimeMin  = pe.lifetimeMin;
-            ps->config.lifetimeMax  = pe.lifetimeMax;
-            ps->config.velocityMin  = { pe.velocityMin[0], pe.velocityMin[1], pe.velocityMin[2] };
-            ps->config.velocityMax  = { pe.velocityMax[0], pe.velocityMax[1], pe.velocityMax[2] };
-            ps->config.sizeStart    = pe.sizeStart;
-            ps->config.sizeEnd      = pe.sizeEnd;
-            ps->config.colorStart   = { pe.colorStart[0], pe.colorStart[1], pe.colorStart[2], pe.colorStart[3] };
-            ps->config.colorEnd     = { pe.colorEnd[0], pe.colorEnd[1], pe.colorEnd[2], pe.colorEnd[3] };
-            ps->config.gravity      = { pe.gravity[0], pe.gravity[1], pe.gravity[2] };
-            ps->config.spawnRadius  = pe.spawnRadius;
-            ps->config.atlasColumns    = pe.atlasColumns;
-            ps->config.atlasRows       = pe.atlasRows;
-            ps->config.atlasFrameCount = pe.atlasFrameCount;
-            ps->config.atlasSpeed      = pe.atlasSpeed;
-            ps->config.softDistance    = pe.softDistance;
-            if (!ps->Init(device, GetShaders()))
-            {
-                SE_LOG_WARN("Failed to init particle emitter");
-                continue;
-            }
-            ps->SetPosition({ pe.position[0], pe.position[1], pe.position[2] });
-            if (!pe.texture.empty())
+            if (sm.alphaMode == SE::AlphaMode::Opaque && sm.albedo && sm.albedo->HasAlpha())
             {
-                auto toW = [](const std::string& s) { return std::wstring(s.begin(), s.end()); };
-                ps->SetTexture(GetAssets().GetTexture(toW(pe.texture)));
+                sm.alphaMode   = SE::AlphaMode::Cutout;
+                sm.alphaCutoff = cutoff;
             }
-            m_particleSystems.push_back(std::move(ps));
         }
-
-        // Update window title
-        std::wstring title = L"FoxEngine " + std::wstring(desc.name.begin(), desc.name.end());
-        SetWindowTextW(GetWindow().GetHandle(), title.c_str());
-
-        return true;
     }
 
     void ResetBall()
     {
         m_ballTransform->position = m_ballSpawn;
         m_ballRigidBody->velocity = { 0.0f, 0.0f, 0.0f };
+        m_ballRigidBody->previousPosition = m_ballSpawn;
+        m_ballRigidBody->WakeUp();
+    }
+
+    // Brings the visibility index up to date with this frame's transforms,
+    // indexing the Bistro mesh and any renderer it hasn't seen yet.
+    void SyncVisibility()
+    {
+        if (m_mesh)
+        {
+            if (m_bistroVisId == SE::VisibilityIndex::k_Invalid)
+                m_bistroVisId = m_visibility.AddObject(*m_mesh, &m_subMats, m_meshWorld);
+            else
+                m_visibility.SetTransform(m_bistroVisId, m_meshWorld);
+        }
+        m_scene.View<SE::MeshRendererComponent, SE::TransformComponent>().Each(
+            [&](SE::MeshRendererComponent& r, const SE::TransformComponent& t)
+            {
+                if (!r.mesh || !r.materials) return;
+                if (r.visibilityId == SE::VisibilityIndex::k_Invalid)
+                    r.visibilityId = m_visibility.AddObject(*r.mesh, r.materials, t.GetWorldMatrix(), r.castShadow);
+                else
+                    m_visibility.SetTransform(r.visibilityId, t.GetWorldMatrix());
+            });
     }
 
 protected:
     void OnUpdate() override
     {
-        // Handle pending scene load (deferred to avoid mid-frame state issues)
+        // Start a pending scene switch; it streams in over the next frames.
         if (!m_pendingSceneLoad.empty())
         {
-            ApplyScene(m_pendingSceneLoad);
+            RequestScene(m_pendingSceneLoad);
             m_pendingSceneLoad.clear();
         }
 
@@ -362,7 +608,9 @@ protected:
         }
 
         m_scene.Update(dt);
-        m_physicsWorld.Step(dt);
+        m_physicsWorld.Simulate(dt);
+        m_scene.UpdateTransforms();
+        const XMFLOAT3 ballPos = m_physicsWorld.GetInterpolatedPosition(*m_ballTransform, *m_ballRigidBody);
         for (auto& ps : m_particleSystems)
             ps->Update(GetRenderer().GetContext(), dt);
 
@@ -373,7 +621,8 @@ protected:
         DrawUI(view, proj);
 
         // Use bistro entity's transform for mesh world matrix
-        m_meshWorld = m_bistroTransform->GetLocalMatrix();
+        m_meshWorld = m_bistroTransform->GetWorldMatrix();
+        SyncVisibility();
 
         // Cascaded shadow pass
         {
@@ -384,8 +633,8 @@ protected:
             for (int c = 0; c < SE::CSM_NUM_CASCADES; ++c)
             {
                 m_shadowMap.BeginCascade(ctx, c);
-                if (m_mesh) m_shadowMap.DrawMesh(ctx, *m_mesh, m_meshWorld);
-                m_shadowMap.DrawSphere(ctx, m_ballTransform->position, m_ballRadius);
+                m_shadowMap.DrawCasters(ctx, m_visibility);
+                m_shadowMap.DrawSphere(ctx, ballPos, m_ballRadius);
                 m_shadowMap.EndCascade(ctx);
             }
         }
@@ -401,7 +650,7 @@ protected:
                 for (int face = 0; face < 6; ++face)
                 {
                     m_pointShadowMaps[li].BeginFace(ctx, face, light.position, light.radius);
-                    if (m_mesh) m_pointShadowMaps[li].DrawMesh(ctx, *m_mesh, m_meshWorld);
+                    m_pointShadowMaps[li].DrawCasters(ctx, m_visibility);
                     m_pointShadowMaps[li].EndFace(ctx);
                 }
             }
@@ -411,7 +660,7 @@ protected:
         if (m_spotLight.enabled)
         {
             m_spotLight.BeginShadowPass(ctx);
-            if (m_mesh) m_spotLight.DrawMesh(ctx, *m_mesh, m_meshWorld);
+            m_spotLight.DrawCasters(ctx, m_visibility);
             m_spotLight.EndShadowPass(ctx);
         }
 
@@ -451,12 +700,9 @@ protected:
         m_pipeline.SetMaterialParams(ctx,
             { m_matTint[0], m_matTint[1], m_matTint[2] }, m_roughnessScale, m_metallic,
             m_debugShadow ? 1.0f : 0.0f);
-        if (m_mesh)
-        {
-            m_pipeline.SubmitMesh(*m_mesh, m_meshWorld, m_subMats);
-            m_pipeline.Flush(ctx);
-        }
-        m_pipeline.DrawSphere(ctx, m_ballTransform->position, m_ballRadius, { 1.0f, 0.45f, 0.05f });
+        m_pipeline.SubmitVisible(m_visibility);
+        m_pipeline.Flush(ctx);
+        m_pipeline.DrawSphere(ctx, ballPos, m_ballRadius, { 1.0f, 0.45f, 0.05f });
 
         // JSON-driven scene objects — texture maps drive all PBR values (scalars = 1.0)
         for (auto& lo : m_sceneObjects)
@@ -495,7 +741,7 @@ protected:
 
         if (m_showColliders)
         {
-            m_pipeline.DrawWireSphere(ctx, m_ballTransform->position, m_ballRadius,
+            m_pipeline.DrawWireSphere(ctx, ballPos, m_ballRadius,
                                       { 0.0f, 1.0f, 0.2f });
             m_pipeline.DrawWireBox(ctx, m_obbFloor.GetWorldMatrix(), { 1.0f, 0.85f, 0.1f });
 
@@ -683,23 +929,41 @@ private:
                 GetAssets().CachedMeshCount(), GetAssets().CachedTextureCount(),
                 m_mesh ? m_mesh->GetSubMeshCount() : 0u);
             dl->AddText(ImVec2(10.0f, 26.0f), IM_COL32(200, 200, 200, 180), buf);
+            const SE::FrameMemoryStats& mem = GetFrameMemory();
+            if constexpr (SE::k_HeapCounters)
+                sprintf_s(buf, "heap: %llu allocs, %.1f KB/frame  |  arena: %.1f / %.0f KB",
+                    mem.heapAllocations, mem.heapBytes / 1024.0,
+                    mem.arenaBytes / 1024.0, mem.arenaCapacity / 1024.0);
+            else
+                sprintf_s(buf, "heap: not counted  |  arena: %.1f / %.0f KB",
+                    mem.arenaBytes / 1024.0, mem.arenaCapacity / 1024.0);
+            dl->AddText(ImVec2(10.0f, 42.0f), IM_COL32(200, 200, 200, 180), buf);
+            sprintf_s(buf, "submeshes visible:%u  culled:%u  |  index: %u proxies, height %d",
+                m_pipeline.GetLastVisibleCount(), m_pipeline.GetLastCulledCount(),
+                m_visibility.GetProxyCount(), m_visibility.GetTreeHeight());
+            dl->AddText(ImVec2(10.0f, 58.0f), IM_COL32(200, 200, 200, 180), buf);
+            const SE::BindStats& binds = m_pipeline.GetLastBindStats();
+            sprintf_s(buf, "draws:%u  state calls issued:%u  skipped:%u",
+                m_pipeline.GetLastDrawCalls(), binds.issued, binds.skipped);
+            dl->AddText(ImVec2(10.0f, 74.0f), IM_COL32(200, 200, 200, 180), buf);
         }
 
         // --- Scene Picker ---
         ImGui::Begin("Scene");
         if (!m_sceneFiles.empty())
         {
-            auto getFilename = [](const std::string& path) -> std::string {
+            // Points into the path itself; no per-frame string copies.
+            auto getFilename = [](const std::string& path) -> const char* {
                 auto pos = path.find_last_of("\\/");
-                return (pos != std::string::npos) ? path.substr(pos + 1) : path;
+                return path.c_str() + ((pos != std::string::npos) ? pos + 1 : 0);
             };
 
-            if (ImGui::BeginCombo("Scene File", getFilename(m_sceneFiles[m_selectedScene]).c_str()))
+            if (ImGui::BeginCombo("Scene File", getFilename(m_sceneFiles[m_selectedScene])))
             {
                 for (int i = 0; i < (int)m_sceneFiles.size(); ++i)
                 {
                     bool selected = (i == m_selectedScene);
-                    if (ImGui::Selectable(getFilename(m_sceneFiles[i]).c_str(), selected))
+                    if (ImGui::Selectable(getFilename(m_sceneFiles[i]), selected))
                     {
                         if (i != m_selectedScene)
                         {
@@ -717,6 +981,31 @@ private:
                 m_sceneFiles = SE::SceneLoader::ScanSceneDirectory("Assets/Scenes");
         }
         ImGui::Text("Active: %s", m_currentDesc.name.c_str());
+        if (m_streaming)
+        {
+            const PendingScene& p = *m_streaming;
+            if (p.stage == PendingScene::Stage::Placements)
+                ImGui::Text("Loading %s: placing batch %zu / %zu", p.path.c_str(), p.nextBatch + 1, p.batches.size());
+            else
+                ImGui::Text("Loading %s...", p.path.c_str());
+        }
+        float loadBudget = static_cast<float>(GetLoader().GetBudget());
+        if (ImGui::SliderFloat("Load budget (ms)", &loadBudget, 0.5f, 16.0f, "%.1f"))
+            GetLoader().SetBudget(loadBudget);
+        ImGui::Text("Loader: %.2f ms last frame", GetLoader().GetLastPumpMs());
+        if (ImGui::CollapsingHeader("Memory Pools"))
+        {
+            auto poolRow = [](const char* name, const SE::PoolStats& st)
+            {
+                ImGui::Text("%-28s %6u / %6u  %3u blocks  %7.1f KB",
+                    name, st.live, st.capacity, st.blocks, st.bytes / 1024.0);
+            };
+            poolRow("Entity", m_scene.GetEntityPoolStats());
+            m_scene.ForEachComponentPool([&](const SE::ComponentPoolBase& pool)
+            {
+                poolRow(pool.GetTypeName(), pool.GetStats());
+            });
+        }
         ImGui::End();
 
         // --- Camera ---
@@ -777,6 +1066,7 @@ private:
             m_obbFloor = SE::OBB::FromAABB({ -30.0f, m_floorY - 0.5f, -30.0f },
                                             {  30.0f, m_floorY,        30.0f });
             m_physicsWorld.AddStaticOBB(m_obbFloor, 0.6f, 0.4f);
+            m_physicsWorld.AddStaticTriangleMesh(m_meshCollider);
         }
         ImGui::Text("pos (%.1f, %.1f, %.1f)",
             m_ballTransform->position.x, m_ballTransform->position.y, m_ballTransform->position.z);
@@ -785,6 +1075,20 @@ private:
         if (ImGui::Button("Reset"))     ResetBall();
         ImGui::SameLine();
         if (ImGui::Button("Launch up")) m_ballRigidBody->AddImpulse({ 0.0f, 20.0f, 0.0f });
+        {
+            const auto& st = m_physicsWorld.GetLastStepStats();
+            ImGui::Text("tick:%llu  step:%.1f ms  alpha:%.2f",
+                static_cast<unsigned long long>(m_physicsWorld.GetTickCount()),
+                m_physicsWorld.GetFixedTimeStep() * 1000.0f, m_physicsWorld.GetInterpolationAlpha());
+            ImGui::Text("bodies:%u  pairs:%u  static:%u", st.bodies, st.spherePairs, st.staticPairs);
+            ImGui::Text("contacts:%u  islands:%u  threads:%u", st.contacts, st.islands, m_physicsWorld.GetThreadCount());
+            ImGui::Text("ccd bodies:%u  hits:%u", st.ccdBodies, st.ccdHits);
+            bool ccd = m_physicsWorld.GetContinuousCollision();
+            if (ImGui::Checkbox("Continuous collision", &ccd)) m_physicsWorld.SetContinuousCollision(ccd);
+            ImGui::Text("sleeping:%u", st.sleeping);
+            bool sleep = m_physicsWorld.GetSleepEnabled();
+            if (ImGui::Checkbox("Sleeping", &sleep)) m_physicsWorld.SetSleepEnabled(sleep);
+        }
         if (m_castRay)
         {
             ImGui::Separator();
@@ -793,7 +1097,8 @@ private:
             {
                 const char* what =
                     m_rayHit.kind == SE::PhysicsWorld::RaycastHit::Kind::Sphere ? "Sphere" :
-                    m_rayHit.kind == SE::PhysicsWorld::RaycastHit::Kind::OBB    ? "OBB"    : "Floor";
+                    m_rayHit.kind == SE::PhysicsWorld::RaycastHit::Kind::OBB    ? "OBB"    :
+                    m_rayHit.kind == SE::PhysicsWorld::RaycastHit::Kind::TriangleMesh ? "Mesh" : "Floor";
                 ImGui::Text("Hit: %s  t=%.2f", what, m_rayHit.t);
                 ImGui::Text("pos  (%.1f, %.1f, %.1f)",
                     m_rayHit.point.x,  m_rayHit.point.y,  m_rayHit.point.z);
@@ -861,6 +1166,30 @@ private:
             ImGui::RadioButton("Force Lit", &dlm, 1); ImGui::SameLine();
             ImGui::RadioButton("NdotL",     &dlm, 2);
             m_lights.debugLightMode = (float)dlm;
+
+            // Caster submeshes drawn / culled per shadow pass
+            ImGui::Text("Shadow casters: %u", m_visibility.GetCasterCount());
+            for (int c = 0; c < SE::CSM_NUM_CASCADES; ++c)
+            {
+                const auto& st = m_shadowMap.GetCasterStats(c);
+                ImGui::Text("  cascade %d   %5u / %5u", c, st.drawn, st.culled);
+            }
+            for (int li = 0; li < 2 && li < m_lights.numLights; ++li)
+            {
+                if (!m_lightCastsShadow[li]) continue;
+                ImGui::Text("  point %d", li);
+                for (int face = 0; face < 6; ++face)
+                {
+                    const auto& st = m_pointShadowMaps[li].GetFaceStats(face);
+                    ImGui::SameLine();
+                    ImGui::Text("%u/%u", st.drawn, st.culled);
+                }
+            }
+            if (m_spotLight.enabled)
+            {
+                const auto& st = m_spotLight.GetCasterStats();
+                ImGui::Text("  spot        %5u / %5u", st.drawn, st.culled);
+            }
         }
         ImGui::End();
 
@@ -1032,6 +1361,8 @@ private:
     SE::SkyboxRenderer                       m_skybox;
     SE::LightEnvironment                     m_lights;
     SE::ForwardPipeline                      m_pipeline;
+    SE::VisibilityIndex                      m_visibility;    // Bistro + MeshRendererComponents
+    uint32_t                                 m_bistroVisId = SE::VisibilityIndex::k_Invalid;
     SE::CascadedShadowMap                    m_shadowMap;
     SE::AssetHandle<SE::Mesh>                m_mesh;
     std::vector<SE::ForwardPipeline::SubMat> m_subMats;
@@ -1043,6 +1374,66 @@ private:
     };
     std::vector<LoadedObject> m_sceneObjects;
 
+    // Per prefab name; MeshRendererComponents point at the materials.
+    struct PrefabAssets
+    {
+        SE::AssetHandle<SE::Mesh>                mesh;
+        std::vector<SE::ForwardPipeline::SubMat> mats;
+    };
+    std::unordered_map<std::string, PrefabAssets> m_prefabAssets;
+
+    // Filled by PrepareScene on the loader thread, then finished slice by
+    // slice by StreamScene and moved into the members above by CommitScene.
+    struct PendingScene
+    {
+        enum class Stage { Entities, Placements, Particles, Commit };
+
+        struct Batch
+        {
+            SE::Prefab                         prefab;
+            std::vector<SE::InstanceTransform> transforms;
+        };
+
+        std::string                        path;
+        std::chrono::steady_clock::time_point start;
+        uint64_t                           startFrame = 0;
+        std::atomic<bool>                  cancelled{ false };
+        bool                               loaded    = false; // PrepareScene succeeded
+        bool                               committed = false;
+
+        // Loader thread
+        SE::SceneDescriptor                           desc;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> skybox;
+        SE::AssetHandle<SE::Mesh>                     mesh;
+        std::vector<SE::ForwardPipeline::SubMat>      subMats;
+        std::shared_ptr<const SE::TriangleMesh>       collider;
+        std::vector<LoadedObject>                     objects;
+        std::unordered_map<std::string, PrefabAssets> prefabAssets;
+        std::vector<Batch>                            batches;
+        std::vector<SE::AssetHandle<SE::Texture2D>>   particleTextures; // per emitter
+
+        // Main thread
+        Stage                                         stage = Stage::Entities;
+        SE::Scene                                     scene;
+        SE::CameraComponent*                          camera        = nullptr;
+        SE::TransformComponent*                       meshTransform = nullptr;
+        SE::TransformComponent*                       ballTransform = nullptr;
+        SE::RigidBodyComponent*                       ballRigidBody = nullptr;
+        std::vector<std::unique_ptr<SE::ParticleSystem>> particles;
+        size_t                                        nextBatch    = 0;
+        size_t                                        nextInstance = 0;
+        size_t                                        nextEmitter  = 0;
+    };
+    std::shared_ptr<PendingScene> m_streaming;
+
+    // What CommitScene replaced, handed to the loader thread to destroy.
+    struct RetiredScene
+    {
+        SE::Scene                                        scene;
+        std::unordered_map<std::string, PrefabAssets>    prefabAssets;
+        std::vector<std::unique_ptr<SE::ParticleSystem>> particles;
+    };
+
     SE::Scene            m_scene;
     SE::CameraComponent* m_camera  = nullptr;
     SE::CameraController m_camCtrl;
@@ -1059,6 +1450,7 @@ private:
     float                   m_ballRadius    = 1.0f;
     float                   m_floorY        = 0.0f;
     SE::OBB                 m_obbFloor;
+    std::shared_ptr<const SE::TriangleMesh> m_meshCollider;
     SE::CharacterController m_cc;
 
     bool                         m_gravityEnabled    = true;
@@ -1100,11 +1492,48 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int)
     desc.width  = 1280;
     desc.height = 720;
 
-    // Parse --scene argument
+    // Parse --scene / --bench / --cook arguments
     std::string scenePath;
     if (lpCmdLine && strlen(lpCmdLine) > 0)
     {
         std::string args(lpCmdLine);
+
+        // Headless benchmarks: no window, no device.
+        auto benchPos = args.find("--bench");
+        if (benchPos != std::string::npos)
+        {
+            benchPos += 7; // skip "--bench"
+            while (benchPos < args.size() && (args[benchPos] == ' ' || args[benchPos] == '=')) ++benchPos;
+            auto end = args.find(' ', benchPos);
+            std::string which = args.substr(benchPos, end - benchPos);
+            return Bench::Run(which.empty() ? "all" : which);
+        }
+
+        // Cook every JSON scene (or just the one named) to .fxscene and exit.
+        auto cookPos = args.find("--cook");
+        if (cookPos != std::string::npos)
+        {
+            cookPos += 6; // skip "--cook"
+            while (cookPos < args.size() && (args[cookPos] == ' ' || args[cookPos] == '=')) ++cookPos;
+            auto end = args.find(' ', cookPos);
+            std::string which = args.substr(cookPos, end - cookPos);
+
+            SE::Logger::Get().Initialize("FoxEngine_cook.log");
+            std::vector<std::string> files;
+            if (which.empty())
+                files = SE::SceneLoader::ScanSceneDirectory("Assets/Scenes");
+            else if (which.find('/') == std::string::npos && which.find('\\') == std::string::npos)
+                files.push_back("Assets/Scenes/" + which);
+            else
+                files.push_back(which);
+
+            int failed = 0;
+            for (const auto& f : files)
+                if (!SE::SceneLoader::Cook(f)) ++failed;
+            SE::Logger::Get().Shutdown();
+            return failed == 0 ? 0 : 1;
+        }
+
         auto pos = args.find("--scene");
         if (pos != std::string::npos)
         {